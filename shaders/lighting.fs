@@ -3,6 +3,7 @@
 in vec3 fragPos;
 in vec3 fragNormal;
 in vec2 fragTexCoord;
+in vec4 fragTint;      // per-instance color (white when not instanced)
 
 out vec4 finalColor;
 
@@ -85,7 +86,7 @@ void main()
     vec3 specular = u_lightColor * spec * 0.3;
     
     // Sample texture
-    vec4 texColor = texture(texture0, fragTexCoord) * colDiffuse;
+    vec4 texColor = texture(texture0, fragTexCoord) * colDiffuse * fragTint;
     
     // Calculate shadow factor
     float shadowFactor = ComputeShadowFactor(fragPos, N, L);
@@ -4,21 +4,42 @@ in vec3 vertexPosition;
 in vec2 vertexTexCoord;
 in vec3 vertexNormal;
 
-uniform mat4 mvp;
+// Per-instance attributes (instanced draws only, see InstanceBatcher)
+in mat4 instanceTransform;
+in vec4 instanceColor;
+
+uniform mat4 mvp;          // instanced: view * projection only
 uniform mat4 matModel;
 uniform mat4 matNormal;
+uniform int  u_instanced;
 
 out vec3 fragPos;
 out vec3 fragNormal;
 out vec2 fragTexCoord;
+out vec4 fragTint;
 
 void main()
 {
-    vec4 worldPos = matModel * vec4(vertexPosition, 1.0);
+    if (u_instanced != 0)
+    {
+        vec4 worldPos = instanceTransform * vec4(vertexPosition, 1.0);
 
-    fragPos      = worldPos.xyz;
-    fragNormal   = normalize((matNormal * vec4(vertexNormal, 0.0)).xyz);
-    fragTexCoord = vertexTexCoord;
+        fragPos    = worldPos.xyz;
+        fragNormal = normalize(transpose(inverse(mat3(instanceTransform))) * vertexNormal);
+        fragTint   = instanceColor;
+
+        gl_Position = mvp * worldPos;
+    }
+    else
+    {
+        vec4 worldPos = matModel * vec4(vertexPosition, 1.0);
 
-    gl_Position = mvp * vec4(vertexPosition, 1.0);
+        fragPos    = worldPos.xyz;
+        fragNormal = normalize((matNormal * vec4(vertexNormal, 0.0)).xyz);
+        fragTint   = vec4(1.0);
+
+        gl_Position = mvp * vec4(vertexPosition, 1.0);
+    }
+
+    fragTexCoord = vertexTexCoord;
 }
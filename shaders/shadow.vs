@@ -2,9 +2,16 @@
 
 in vec3 vertexPosition;
 
-uniform mat4 mvp;
+// Per-instance model matrix (instanced draws only, see InstanceBatcher)
+in mat4 instanceTransform;
+
+uniform mat4 mvp;          // instanced: light view * projection only
+uniform int  u_instanced;
 
 void main()
 {
-    gl_Position = mvp * vec4(vertexPosition, 1.0);
+    if (u_instanced != 0)
+        gl_Position = mvp * (instanceTransform * vec4(vertexPosition, 1.0));
+    else
+        gl_Position = mvp * vec4(vertexPosition, 1.0);
 }
\ No newline at end of file
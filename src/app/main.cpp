@@ -1,20 +1,38 @@
 #include "raylib.h"
 
+#include "FixedTimestep.h"
+#include "JobSystem.h"
+#include "MainThreadQueue.h"
 #include "RenderPipeline.h"
 #include "SceneManager.h"
 #include "DemoScene3D.h"
 
+#include <functional>
+
 int main()
 {
     // Declare screen dimensions
     const int SCREEN_WIDTH  = 1280;
     const int SCREEN_HEIGHT = 720;
 
+    // Simulation rate (independent of the render rate) and catch-up cap
+    const float SIMULATION_HZ       = 60.0f;
+    const int   MAX_STEPS_PER_FRAME = 5;
+
+    // Binary scene file for the demo (F6 writes it, F5 / next start load it)
+    const char* DEMO_SCENE_FILE = "resources/demo.scene";
+
     // Initialize raylib window
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "3DSRC");
     SetTargetFPS(60);
     DisableCursor();
 
+    // GL calls must stay on this thread; async scene loads queue them here
+    MainThreadQueue::MarkMainThread();
+
+    // Worker threads for parallel component updates (hardware threads - 1)
+    JobSystem jobSystem;
+
     // Initialize render pipeline
     RenderPipeline pipeline(SCREEN_WIDTH, SCREEN_HEIGHT);
     if (!pipeline.Initialize())
@@ -25,18 +43,37 @@ int main()
 
     // Create and start the 3D demo scene, bound to this pipeline
     SceneManager sceneManager;
-    sceneManager.MakeScene<DemoScene3D>(pipeline);
+    sceneManager.MakeScene<DemoScene3D>(pipeline, DEMO_SCENE_FILE);
+
+    // Fixed-step simulation clock
+    FixedTimestep timestep(SIMULATION_HZ, MAX_STEPS_PER_FRAME);
 
     // Main loop
     while (!WindowShouldClose())
     {
-        float dt = GetFrameTime();
+        float frameTime = GetFrameTime();
+
+        // SCENE LOADING (F5 reloads the demo scene in the background, F6 saves it)
+        if (IsKeyPressed(KEY_F5))
+            sceneManager.LoadSceneAsync<DemoScene3D>(std::ref(pipeline), DEMO_SCENE_FILE);
+        if (IsKeyPressed(KEY_F6))
+            sceneManager.ExportScene(DEMO_SCENE_FILE);
+        sceneManager.PumpLoading();
+
+        // PER-FRAME INPUT (mouse look, key presses)
+        sceneManager.FrameUpdate(frameTime);
 
-        // GAME / SIMULATION STEP
-        sceneManager.Update(dt);
-        sceneManager.LateUpdate(dt);
+        // GAME / SIMULATION STEPS (fixed dt, 0..MAX_STEPS_PER_FRAME per frame)
+        const float step  = timestep.GetStep();
+        const int   steps = timestep.Advance(frameTime);
+        for (int i = 0; i < steps; ++i)
+        {
+            sceneManager.Update(step);
+            sceneManager.LateUpdate(step);
+        }
 
-        // RENDER STEP
+        // RENDER STEP (interpolated between the last two simulation states)
+        pipeline.SetInterpolationAlpha(timestep.GetAlpha());
         sceneManager.Draw(pipeline);
     }
 
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Build flag: set to 0 (e.g. CFLAGS += -DCHUNK_POOL_STORAGE=0) to fall back to
+// one heap allocation per component and per GameObject.
+#ifndef CHUNK_POOL_STORAGE
+#define CHUNK_POOL_STORAGE 1
+#endif
+
+// ChunkPool<T>:
+// - Stores every object of type T in fixed-size chunks, so objects of the same
+//   type sit next to each other in memory instead of being scattered heap blocks.
+// - Destroyed slots go onto a free list and are reused by the next Create().
+// - Only the placement changes: callers still reach the objects through their
+//   own pointers (GameObject component lists, SceneGraph slots), not by walking
+//   the pool. One pool is shared by every scene, including one being built on a
+//   loader worker, so a pool walk would also see half-built scenes.
+// - Create()/Destroy() are thread-safe (scenes may be built on a worker thread).
+template <typename T>
+class ChunkPool
+{
+public:
+    // Number of objects per chunk. Chunks are never moved once allocated,
+    // so pointers handed out by Create() stay valid until Destroy().
+    static constexpr std::size_t ChunkCapacity = 64;
+
+    // One pool per type, created on first use.
+    static ChunkPool& Instance()
+    {
+        static ChunkPool pool;
+        return pool;
+    }
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    // Construct a T in the next free slot.
+    template <typename... Args>
+    T* Create(Args&&... args)
+    {
+        Slot* slot = AcquireSlot();
+
+        T* object = nullptr;
+        try
+        {
+            object = new (&slot->storage) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            ReleaseSlot(slot);
+            throw;
+        }
+
+        return object;
+    }
+
+    // Destroy a T previously returned by Create() and recycle its slot.
+    void Destroy(T* object)
+    {
+        if (!object)
+            return;
+
+        // storage is the first member of the standard-layout Slot.
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        object->~T();
+        ReleaseSlot(slot);
+    }
+
+    std::size_t Count() const { return liveCount; }
+    std::size_t ChunkCount() const { return chunks.size(); }
+
+private:
+    struct Slot
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    struct Chunk
+    {
+        Slot slots[ChunkCapacity];
+    };
+
+    ChunkPool() = default;
+
+    // Take a free slot (growing by one chunk if needed).
+    Slot* AcquireSlot()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeSlots.empty())
+            AddChunk();
+
+        Slot* slot = freeSlots.back();
+        freeSlots.pop_back();
+        ++liveCount;
+        return slot;
+    }
+
+    void ReleaseSlot(Slot* slot)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeSlots.push_back(slot);
+        --liveCount;
+    }
+
+    void AddChunk()
+    {
+        chunks.emplace_back(new Chunk());
+        Chunk& chunk = *chunks.back();
+
+        // Push in reverse so slots are handed out front-to-back.
+        for (std::size_t i = ChunkCapacity; i-- > 0;)
+            freeSlots.push_back(&chunk.slots[i]);
+    }
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<Slot*> freeSlots;
+    std::size_t liveCount = 0;
+    std::mutex mutex;
+};
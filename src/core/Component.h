@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 class GameObject;
 
 class Component {
@@ -14,13 +16,57 @@ public:
     GameObject* GetGameObject() const { return gameObject; }
 
     bool IsEnabled() const { return enabled; }
-    void SetEnabled(bool value) { enabled = value; }
+    void SetEnabled(bool value);   // also wakes the object (see CanSleep)
+
+    // Opt-in for parallel Update/LateUpdate on worker threads (see SceneGraph).
+    // A parallel-safe component may only read/write its own GameObject's state,
+    // must not write transforms that have children, and must not call raylib.
+    // Everything else stays on the main thread, in scene order.
+    virtual bool IsParallelSafe() const { return false; }
+
+    // Opt-in for sleeping (see SceneGraph). An object whose transform has not
+    // changed for a while stops getting FrameUpdate/Update/LateUpdate until it
+    // moves, gets a trigger event or is woken with GameObject::WakeUp().
+    // Components without step callbacks never keep their object awake; ones with
+    // them return true here if their work only depends on the object's own
+    // state (and wake it themselves when that state changes).
+    virtual bool CanSleep() const { return false; }
 
     virtual void Start() {}
+
+    // Called once when the owning GameObject is destroyed (at the end of the
+    // fixed step in which Destroy() was requested, or with its scene). Other
+    // objects destroyed in the same batch are still alive at this point.
+    virtual void OnDestroy() {}
+
+    // Once per rendered frame with the variable frame time, before the fixed
+    // simulation steps. Use it for per-frame input (mouse look, key presses);
+    // Update/LateUpdate run at the fixed simulation rate (0..N times per frame).
+    virtual void FrameUpdate(float deltaTime) {}
+
     virtual void Update(float deltaTime) {}
     virtual void LateUpdate(float deltaTime) {}
+
+    // Trigger overlaps (see Collider::SetTrigger), delivered in a batch after the
+    // scene's PhysicsWorld syncs. Both objects of a pair are told, each getting
+    // the other one; on exit other is null if that object was destroyed.
+    virtual void OnTriggerEnter(GameObject* other) {}
+    virtual void OnTriggerExit(GameObject* other) {}
     virtual void Draw() {}
 
     // NEW: depth-only pass for shadow rendering
     virtual void DrawShadow() {}
 };
+
+namespace ComponentActivity
+{
+    // True if T overrides a step callback (FrameUpdate, Update or LateUpdate).
+    // An inherited callback names Component's member, an override T's (or a base's).
+    template <typename T>
+    constexpr bool HasStepWork()
+    {
+        return !std::is_same<decltype(&T::FrameUpdate), void (Component::*)(float)>::value ||
+               !std::is_same<decltype(&T::Update),      void (Component::*)(float)>::value ||
+               !std::is_same<decltype(&T::LateUpdate),  void (Component::*)(float)>::value;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <utility>
+
+#include "ChunkPool.h"
+
+class Component;
+
+// ComponentStorage:
+// Single place deciding where components live (chunk pools or plain heap).
+// GameObject stores the returned release function next to each component.
+namespace ComponentStorage
+{
+    using ReleaseFn = void (*)(Component*);
+
+    template <typename T>
+    void Release(Component* component)
+    {
+#if CHUNK_POOL_STORAGE
+        ChunkPool<T>::Instance().Destroy(static_cast<T*>(component));
+#else
+        delete static_cast<T*>(component);
+#endif
+    }
+
+    template <typename T, typename... Args>
+    T* Create(Args&&... args)
+    {
+#if CHUNK_POOL_STORAGE
+        return ChunkPool<T>::Instance().Create(std::forward<Args>(args)...);
+#else
+        return new T(std::forward<Args>(args)...);
+#endif
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Dense integer id per component type, used by GameObject for constant-time
+// component lookup instead of dynamic_cast scans.
+using ComponentTypeId = std::uint32_t;
+
+namespace ComponentType
+{
+    // Hands out the next free id. Ids are process-wide and start at 0.
+    inline ComponentTypeId NextId()
+    {
+        static std::atomic<ComponentTypeId> counter{ 0 };
+        return counter++;
+    }
+
+    // Id for T, assigned the first time T is asked for and stable afterwards.
+    // Note: ids identify the exact type; a lookup for a base class does not
+    // match components of derived types.
+    template <typename T>
+    ComponentTypeId Id()
+    {
+        static const ComponentTypeId id = NextId();
+        return id;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+/// Fixed-step accumulator for the simulation loop.
+/// Each rendered frame adds its variable frame time, and Advance() reports how
+/// many fixed steps to simulate. Leftover time becomes the interpolation alpha
+/// used to blend the previous and current simulation states for rendering.
+class FixedTimestep
+{
+public:
+    // hz: simulation rate. maxSteps: cap per frame so a long hitch drops time
+    // instead of spiralling into ever more catch-up steps.
+    explicit FixedTimestep(float hz = 60.0f, int maxSteps = 5)
+    {
+        SetRate(hz);
+        SetMaxSteps(maxSteps);
+    }
+
+    void SetRate(float hz) { step = (hz > 0.0f) ? 1.0f / hz : 1.0f / 60.0f; }
+    float GetStep() const { return step; }
+
+    void SetMaxSteps(int steps) { maxSteps = (steps > 0) ? steps : 1; }
+    int GetMaxSteps() const { return maxSteps; }
+
+    // Add a frame's worth of time and return the number of fixed steps to run.
+    int Advance(float frameTime)
+    {
+        if (frameTime > 0.0f)
+            accumulator += frameTime;
+
+        int steps = static_cast<int>(accumulator / step);
+        if (steps > maxSteps)
+        {
+            // Too far behind: run the cap and throw the rest away.
+            steps       = maxSteps;
+            accumulator = static_cast<float>(maxSteps) * step;
+        }
+
+        accumulator -= static_cast<float>(steps) * step;
+        return steps;
+    }
+
+    // How far (0..1) we are between the last simulated state and the next one.
+    float GetAlpha() const
+    {
+        float alpha = accumulator / step;
+        return alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    }
+
+private:
+    float step        = 1.0f / 60.0f;
+    float accumulator = 0.0f;
+    int   maxSteps    = 5;
+};
@@ -1,82 +1,150 @@
 #include "GameObject.h"
+#include "SceneGraph.h"
+
+#include <algorithm>
+#include <cstdio>
 
 GameObject::GameObject(const std::string& name) : name(name) {
-    AddComponent<Transform3D>();
+    transform = AddComponent<Transform3D>();
+}
+
+GameObject::~GameObject() {
+    // Release in reverse order of creation, so the Transform3D goes last.
+    for (auto it = components.rbegin(); it != components.rend(); ++it) {
+        it->release(it->component);
+    }
+    components.clear();
 }
 
 const std::string& GameObject::GetName() const { return name; }
 void GameObject::SetName(const std::string& n) { name = n; }
 
 bool GameObject::IsActive() const { return active; }
-void GameObject::SetActive(bool value) { active = value; }
 
-Transform3D* GameObject::GetTransform() {
-    return GetComponent<Transform3D>();
+bool GameObject::IsActiveInHierarchy() const {
+    for (const GameObject* obj = this; obj; obj = obj->parent) {
+        if (!obj->active) return false;
+    }
+    return true;
+}
+
+void GameObject::SetActive(bool value) {
+    if (active == value) return;
+    active = value;
+    WakeUp();
+    if (graph) graph->MarkChanged(this);
+}
+
+void Component::SetEnabled(bool value) {
+    enabled = value;
+    if (gameObject) gameObject->WakeUp();
 }
 
-void GameObject::AddChild(std::shared_ptr<GameObject> child) {
+void GameObject::AddChild(GameObject* child) {
+    if (!child || child == this || child->parent == this) return;
+
+    if (child->graph != graph) {
+        printf("GameObject: cannot parent '%s' under '%s' (different scenes)\n",
+               child->name.c_str(), name.c_str());
+        return;
+    }
+
+    // Refuse to create a cycle (child is one of our ancestors).
+    for (GameObject* p = parent; p; p = p->parent) {
+        if (p == child) return;
+    }
+
+    child->DetachFromParent();
     child->parent = this;
+    child->GetTransform()->SetParent(transform);
     children.push_back(child);
+    if (graph) graph->MarkChanged(child);
 }
 
-const std::vector<std::shared_ptr<GameObject>>& GameObject::GetChildren() const {
+const std::vector<GameObject*>& GameObject::GetChildren() const {
     return children;
 }
 
-void GameObject::Start() {
-    if (!active) return;
-    for (auto& comp : components) {
-        if (comp->IsEnabled()) comp->Start();
-    }
-    for (auto& child : children) {
-        child->Start();
+void GameObject::DetachFromParent() {
+    if (!parent) return;
+
+    auto& siblings = parent->children;
+    siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    parent = nullptr;
+    transform->SetParent(nullptr);
+    if (graph) graph->MarkChanged(this);
+}
+
+void GameObject::Destroy() {
+    if (graph) graph->Destroy(this);
+}
+
+void GameObject::NotifyDestroy() {
+    for (auto& entry : components) {
+        entry.component->OnDestroy();
     }
 }
 
-void GameObject::Update(float deltaTime) {
-    if (!active) return;
-    for (auto& comp : components) {
-        if (comp->IsEnabled()) comp->Update(deltaTime);
+void GameObject::Start() {
+    started = true;
+    for (auto& entry : components) {
+        if (entry.component->IsEnabled()) entry.component->Start();
     }
-    for (auto& child : children) {
-        child->Update(deltaTime);
+}
+
+void GameObject::FrameUpdate(float deltaTime) {
+    for (auto& entry : components) {
+        if (entry.component->IsEnabled()) entry.component->FrameUpdate(deltaTime);
     }
 }
 
-void GameObject::LateUpdate(float deltaTime) {
-    if (!active) return;
-    for (auto& comp : components) {
-        if (comp->IsEnabled()) comp->LateUpdate(deltaTime);
+void GameObject::Update(float deltaTime, UpdateGroup group) {
+    const bool wantParallel = (group == UpdateGroup::Parallel);
+    for (auto& entry : components) {
+        if (entry.parallelSafe != wantParallel) continue;
+        if (entry.component->IsEnabled()) entry.component->Update(deltaTime);
     }
-    for (auto& child : children) {
-        child->LateUpdate(deltaTime);
+}
+
+void GameObject::LateUpdate(float deltaTime, UpdateGroup group) {
+    const bool wantParallel = (group == UpdateGroup::Parallel);
+    for (auto& entry : components) {
+        if (entry.parallelSafe != wantParallel) continue;
+        if (entry.component->IsEnabled()) entry.component->LateUpdate(deltaTime);
     }
 }
 
+void GameObject::OnParallelComponentAdded() {
+    ++parallelComponentCount;
+    // The graph keeps a separate list of objects with parallel work.
+    if (graph) graph->MarkParallelChanged();
+}
+
 void GameObject::Draw() {
-    if (!active) return;
-    for (auto& comp : components) {
-        if (comp->IsEnabled()) comp->Draw();
-    }
-    for (auto& child : children) {
-        child->Draw();
+    for (auto& entry : components) {
+        if (entry.component->IsEnabled()) entry.component->Draw();
     }
 }
 
 void GameObject::DrawShadow()
 {
-    if (!active) return;
-
-    // 1) Components
-    for (auto& comp : components)
+    for (auto& entry : components)
     {
-        if (comp->IsEnabled())
-            comp->DrawShadow();
+        if (entry.component->IsEnabled())
+            entry.component->DrawShadow();
     }
+}
 
-    // 2) Children
-    for (auto& child : children)
-    {
-        child->DrawShadow();
+void GameObject::TriggerEnter(GameObject* other) {
+    WakeUp();
+    for (auto& entry : components) {
+        if (entry.component->IsEnabled()) entry.component->OnTriggerEnter(other);
     }
-}
\ No newline at end of file
+}
+
+void GameObject::TriggerExit(GameObject* other) {
+    WakeUp();
+    for (auto& entry : components) {
+        if (entry.component->IsEnabled()) entry.component->OnTriggerExit(other);
+    }
+}
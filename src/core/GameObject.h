@@ -4,52 +4,180 @@
 #include <vector>
 #include <memory>
 #include "Component.h"
+#include "ComponentStorage.h"
+#include "ComponentType.h"
+#include "GameObjectHandle.h"
 #include "Transform3D.h"
 
+class SceneGraph;
+
+// Selects which components a per-object Update/LateUpdate runs.
+enum class UpdateGroup {
+    MainThread,   // order-sensitive components (default)
+    Parallel      // components that declared IsParallelSafe()
+};
+
 class GameObject {
 private:
+    // A component plus the function that returns it to its storage (chunk pool or heap).
+    struct ComponentEntry {
+        Component* component;
+        ComponentStorage::ReleaseFn release;
+        ComponentTypeId typeId;
+        bool parallelSafe;
+    };
+
     std::string name;
-    std::vector<std::shared_ptr<Component>> components;
-    std::vector<std::shared_ptr<GameObject>> children;
+    std::vector<ComponentEntry> components;
+
+    // First component of each type, indexed by ComponentTypeId (nullptr if none).
+    std::vector<Component*> componentsByType;
+
+    // Every GameObject has a Transform3D; cached so GetTransform() is a plain load.
+    Transform3D* transform = nullptr;
+
+    // Hierarchy. Objects are owned by their SceneGraph, not by their parent.
+    std::vector<GameObject*> children;
     GameObject* parent = nullptr;
+    SceneGraph* graph = nullptr;   // scene that created (and owns) this object
+    GameObjectHandle handle;
     bool active = true;
+    bool started = false;
+    bool destroyRequested = false;
+    int  parallelComponentCount = 0;
+
+    // Activity (see SceneGraph): steps since the last change, and whether the
+    // object sleeps. Components with step work that cannot sleep keep it awake.
+    int  idleSteps = 0;
+    bool sleeping = false;
+    int  wakefulComponentCount = 0;
+
+    // Place in SceneGraph's active array: whether this object is listed there,
+    // and its tree depth when it was listed (marks where its subtree range ends).
+    bool listed = false;
+    int  listedDepth = 0;
+
+    // Created and destroyed only by SceneGraph (CreateObject / Destroy).
+    friend class SceneGraph;
+    friend class ChunkPool<GameObject>;
+
+    explicit GameObject(const std::string& name = "GameObject");
+    ~GameObject();
     
 public:
-    explicit GameObject(const std::string& name = "GameObject");
+    // Components are owned through raw storage slots; copying would double-release them.
+    GameObject(const GameObject&) = delete;
+    GameObject& operator=(const GameObject&) = delete;
+
+    // Stable reference that stays safe to hold after this object is destroyed.
+    GameObjectHandle GetHandle() const { return handle; }
+
+    // Queue this object (and its children) for destruction at the end of the
+    // current fixed step. The object stays valid until then.
+    void Destroy();
+    bool IsDestroyRequested() const { return destroyRequested; }
     
     const std::string& GetName() const;
     void SetName(const std::string& n);
     
     bool IsActive() const;
     void SetActive(bool value);
+
+    // Active itself and all of its ancestors are active.
+    bool IsActiveInHierarchy() const;
     
     template<typename T, typename... Args>
     T* AddComponent(Args&&... args) {
-        auto component = std::make_shared<T>(std::forward<Args>(args)...);
+        T* component = ComponentStorage::Create<T>(std::forward<Args>(args)...);
         component->SetGameObject(this);
-        components.push_back(component);
-        return component.get();
+
+        const ComponentTypeId id = ComponentType::Id<T>();
+        const bool parallelSafe = component->IsParallelSafe();
+        components.push_back({ component, &ComponentStorage::Release<T>, id, parallelSafe });
+        if (parallelSafe)
+            OnParallelComponentAdded();
+        if (ComponentActivity::HasStepWork<T>() && !component->CanSleep())
+            ++wakefulComponentCount;
+        WakeUp();
+
+        if (id >= componentsByType.size())
+            componentsByType.resize(id + 1, nullptr);
+        if (!componentsByType[id])
+            componentsByType[id] = component;
+
+        return component;
     }
     
+    // Returns the first component of exactly type T, or nullptr. O(1).
     template<typename T>
     T* GetComponent() {
-        for (auto& comp : components) {
-            if (auto ptr = dynamic_cast<T*>(comp.get())) {
-                return ptr;
-            }
+        const ComponentTypeId id = ComponentType::Id<T>();
+        if (id >= componentsByType.size())
+            return nullptr;
+        return static_cast<T*>(componentsByType[id]);
+    }
+
+    // Returns every component of exactly type T, in the order they were added.
+    template<typename T>
+    std::vector<T*> GetComponents() {
+        std::vector<T*> result;
+        const ComponentTypeId id = ComponentType::Id<T>();
+        for (auto& entry : components) {
+            if (entry.typeId == id)
+                result.push_back(static_cast<T*>(entry.component));
         }
-        return nullptr;
+        return result;
     }
     
-    Transform3D* GetTransform();
-    
-    void AddChild(std::shared_ptr<GameObject> child);
-    const std::vector<std::shared_ptr<GameObject>>& GetChildren() const;
+    // Visit every component in the order it was added: fn(ComponentTypeId, const Component&).
+    template<typename Fn>
+    void ForEachComponent(Fn&& fn) const {
+        for (const auto& entry : components)
+            fn(entry.typeId, *entry.component);
+    }
+
+    Transform3D* GetTransform() { return transform; }
+
+    // Re-parent child (an object of the same scene) under this object.
+    void AddChild(GameObject* child);
+    const std::vector<GameObject*>& GetChildren() const;
+    GameObject* GetParent() const { return parent; }
+
+    SceneGraph* GetSceneGraph() const { return graph; }
     
+    // Per-object passes: run this object's own components only.
+    // Traversal of the hierarchy is done by SceneGraph over its flattened array.
     void Start();
-    void Update(float deltaTime);
-    void LateUpdate(float deltaTime);
+    bool HasStarted() const { return started; }
+    void FrameUpdate(float deltaTime);
+    void Update(float deltaTime, UpdateGroup group = UpdateGroup::MainThread);
+    void LateUpdate(float deltaTime, UpdateGroup group = UpdateGroup::MainThread);
     void Draw();
 
     void DrawShadow();
+
+    // Forward a trigger event to every enabled component (called by PhysicsWorld).
+    void TriggerEnter(GameObject* other);
+    void TriggerExit(GameObject* other);
+
+    // Sleeping objects skip the step passes (FrameUpdate/Update/LateUpdate) and
+    // PhysicsWorld's collider sync; they are still drawn. A transform change,
+    // a trigger event, enabling a component or activating the object wakes it.
+    bool IsSleeping() const { return sleeping; }
+    void WakeUp() { sleeping = false; idleSteps = 0; }
+
+    // No component keeps the object awake (see Component::CanSleep).
+    bool CanSleep() const { return wakefulComponentCount == 0; }
+
+    // True if any component runs in the parallel update group.
+    bool HasParallelComponents() const { return parallelComponentCount > 0; }
+
+private:
+    void OnParallelComponentAdded();
+
+    // Unlink from the parent's child list (transform included).
+    void DetachFromParent();
+
+    // Tell every component the object is going away (before anything is freed).
+    void NotifyDestroy();
 };
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+// GameObjectHandle:
+// - 32-bit reference to a GameObject owned by a SceneGraph:
+//   low 20 bits = slot index, high 12 bits = slot generation.
+// - The generation changes every time a slot is freed, so a handle to a
+//   destroyed object never resolves again (SceneGraph::Resolve returns nullptr)
+//   even after its slot has been reused.
+// - Generations start at 1, so the default (zero) handle is always null.
+class GameObjectHandle
+{
+public:
+    static constexpr uint32_t IndexBits      = 20;
+    static constexpr uint32_t GenerationBits = 12;
+    static constexpr uint32_t MaxIndex       = (1u << IndexBits) - 1;
+    static constexpr uint32_t MaxGeneration  = (1u << GenerationBits) - 1;
+
+    GameObjectHandle() = default;
+    GameObjectHandle(uint32_t index, uint32_t generation)
+        : value((generation << IndexBits) | (index & MaxIndex)) {}
+
+    uint32_t Index() const      { return value & MaxIndex; }
+    uint32_t Generation() const { return value >> IndexBits; }
+    uint32_t Value() const      { return value; }
+
+    bool IsNull() const { return value == 0; }
+    explicit operator bool() const { return value != 0; }
+
+    bool operator==(const GameObjectHandle& other) const { return value == other.value; }
+    bool operator!=(const GameObjectHandle& other) const { return value != other.value; }
+
+private:
+    uint32_t value = 0;
+};
@@ -0,0 +1,225 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <utility>
+
+struct JobHandle::Group
+{
+    // Jobs of this group that have not finished yet.
+    std::atomic<int> remaining { 0 };
+
+    // Jobs waiting for this group to complete (guarded by mutex).
+    std::mutex mutex;
+    std::vector<std::pair<std::function<void()>, std::shared_ptr<Group>>> waiting;
+};
+
+namespace
+{
+    JobSystem* sInstance = nullptr;
+
+    // Index of the queue owned by the current thread (-1 = not a worker).
+    thread_local int tlsQueueIndex = -1;
+}
+
+bool JobHandle::IsComplete() const
+{
+    return !group || group->remaining.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::JobSystem(int workerCount)
+{
+    if (workerCount < 0)
+    {
+        int hw = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = std::max(hw - 1, 0);
+    }
+
+    // Worker queues first, then the shared queue for external threads.
+    for (int i = 0; i < workerCount + 1; ++i)
+        queues.emplace_back(new Queue());
+
+    for (int i = 0; i < workerCount; ++i)
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+    sInstance = this;
+}
+
+JobSystem::~JobSystem()
+{
+    if (sInstance == this)
+        sInstance = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    sleepCondition.notify_all();
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+JobSystem* JobSystem::Get()
+{
+    return sInstance;
+}
+
+JobHandle JobSystem::Schedule(Job job, const JobHandle& dependency)
+{
+    auto group = std::make_shared<JobHandle::Group>();
+    group->remaining = 1;
+
+    Submit({ std::move(job), group }, dependency);
+    return JobHandle(group);
+}
+
+JobHandle JobSystem::ParallelFor(std::size_t count, std::size_t batchSize, RangeJob fn,
+                                 const JobHandle& dependency)
+{
+    if (count == 0)
+        return dependency;
+
+    batchSize = std::max<std::size_t>(batchSize, 1);
+    const std::size_t batchCount = (count + batchSize - 1) / batchSize;
+
+    auto group = std::make_shared<JobHandle::Group>();
+    group->remaining = static_cast<int>(batchCount);
+
+    // All batches share one copy of the range function.
+    auto shared = std::make_shared<RangeJob>(std::move(fn));
+    for (std::size_t b = 0; b < batchCount; ++b)
+    {
+        const std::size_t begin = b * batchSize;
+        const std::size_t end   = std::min(begin + batchSize, count);
+        Submit({ [shared, begin, end]() { (*shared)(begin, end); }, group }, dependency);
+    }
+
+    return JobHandle(group);
+}
+
+void JobSystem::Wait(const JobHandle& handle)
+{
+    const int queueIndex = tlsQueueIndex >= 0 ? tlsQueueIndex : static_cast<int>(workers.size());
+
+    while (!handle.IsComplete())
+    {
+        if (!TryRunOne(queueIndex))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::Submit(Task task, const JobHandle& dependency)
+{
+    if (dependency.group)
+    {
+        JobHandle::Group& dep = *dependency.group;
+        std::unique_lock<std::mutex> lock(dep.mutex);
+        if (dep.remaining.load(std::memory_order_acquire) > 0)
+        {
+            dep.waiting.emplace_back(std::move(task.job), std::move(task.group));
+            return;
+        }
+    }
+
+    Enqueue(std::move(task));
+}
+
+void JobSystem::Enqueue(Task task)
+{
+    // Workers push onto their own queue; other threads spread round-robin.
+    std::size_t index;
+    if (tlsQueueIndex >= 0)
+        index = static_cast<std::size_t>(tlsQueueIndex);
+    else if (!workers.empty())
+        index = nextQueue++ % workers.size();
+    else
+        index = queues.size() - 1;
+
+    {
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    ++queuedCount;
+
+    // Taking the sleep mutex orders this with a worker that is about to sleep.
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    sleepCondition.notify_one();
+}
+
+bool JobSystem::TryRunOne(int queueIndex)
+{
+    Task task;
+    bool found = false;
+
+    // 1) Own queue, newest first (LIFO keeps caches warm).
+    if (queueIndex >= 0 && queueIndex < static_cast<int>(queues.size()))
+    {
+        Queue& own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // 2) Steal the oldest job from someone else.
+    const int queueCount = static_cast<int>(queues.size());
+    for (int i = 1; !found && i <= queueCount; ++i)
+    {
+        const int victim = (queueIndex + i + queueCount) % queueCount;
+        if (victim == queueIndex)
+            continue;
+
+        Queue& other = *queues[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty())
+        {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    --queuedCount;
+    Run(task);
+    return true;
+}
+
+void JobSystem::Run(Task& task)
+{
+    task.job();
+
+    JobHandle::Group& group = *task.group;
+    if (group.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    // Last job of the group: release everything that was waiting on it.
+    std::vector<std::pair<Job, std::shared_ptr<JobHandle::Group>>> released;
+    {
+        std::lock_guard<std::mutex> lock(group.mutex);
+        released.swap(group.waiting);
+    }
+
+    for (auto& entry : released)
+        Enqueue({ std::move(entry.first), std::move(entry.second) });
+}
+
+void JobSystem::WorkerLoop(int index)
+{
+    tlsQueueIndex = index;
+
+    while (running)
+    {
+        if (TryRunOne(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this]() { return !running || queuedCount > 0; });
+    }
+}
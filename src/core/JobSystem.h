@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// JobHandle:
+// - Refers to a group of jobs (one Schedule() or all batches of one ParallelFor()).
+// - Can be waited on, or passed as the dependency of later jobs.
+// - A default-constructed handle is "already complete".
+class JobHandle
+{
+public:
+    JobHandle() = default;
+
+    // True once every job in the group has finished.
+    bool IsComplete() const;
+
+private:
+    friend class JobSystem;
+
+    struct Group;
+    std::shared_ptr<Group> group;
+
+    explicit JobHandle(std::shared_ptr<Group> g) : group(std::move(g)) {}
+};
+
+// JobSystem:
+// - Fixed pool of worker threads, each with its own job deque.
+// - Workers pop their own newest job first and steal the oldest job from
+//   other workers when they run dry (work stealing).
+// - Jobs may depend on a JobHandle: they are only queued once it completes.
+// - The thread calling Wait() helps run jobs instead of blocking.
+//
+// One instance is created by the application (main.cpp) and is reachable through
+// JobSystem::Get(). When no instance exists, callers fall back to running serially.
+class JobSystem
+{
+public:
+    using Job         = std::function<void()>;
+    using RangeJob    = std::function<void(std::size_t begin, std::size_t end)>;
+
+    // workerCount < 0 picks hardware_concurrency - 1 (the main thread also runs jobs).
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Active instance, or nullptr if none was created.
+    static JobSystem* Get();
+
+    // Queue a single job, optionally after another group completes.
+    JobHandle Schedule(Job job, const JobHandle& dependency = JobHandle());
+
+    // Split [0, count) into batches of batchSize and run fn(begin, end) for each batch.
+    JobHandle ParallelFor(std::size_t count, std::size_t batchSize, RangeJob fn,
+                          const JobHandle& dependency = JobHandle());
+
+    // Block until the group is complete, running queued jobs meanwhile.
+    void Wait(const JobHandle& handle);
+
+    // Number of worker threads (not counting the main thread).
+    int GetWorkerCount() const { return static_cast<int>(workers.size()); }
+
+private:
+    struct Task
+    {
+        Job                                job;
+        std::shared_ptr<JobHandle::Group>  group;
+    };
+
+    // One deque per worker plus one for external (non-worker) threads.
+    struct Queue
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread>             workers;
+    std::vector<std::unique_ptr<Queue>>  queues;
+    std::atomic<bool>                    running { true };
+    std::atomic<int>                     queuedCount { 0 };
+    std::atomic<unsigned>                nextQueue { 0 };
+
+    std::mutex              sleepMutex;
+    std::condition_variable sleepCondition;
+
+    void WorkerLoop(int index);
+
+    // Queue a task whose dependencies are satisfied.
+    void Enqueue(Task task);
+
+    // Queue a task now, or park it on the dependency until that completes.
+    void Submit(Task task, const JobHandle& dependency);
+
+    // Pop from our own queue, else steal. Returns false if nothing was found.
+    bool TryRunOne(int queueIndex);
+
+    void Run(Task& task);
+};
@@ -0,0 +1,69 @@
+#include "MainThreadQueue.h"
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    std::thread::id                    sMainThreadId = std::this_thread::get_id();
+    std::mutex                         sMutex;
+    std::deque<std::function<void()>>  sTasks;
+}
+
+void MainThreadQueue::MarkMainThread()
+{
+    sMainThreadId = std::this_thread::get_id();
+}
+
+bool MainThreadQueue::IsMainThread()
+{
+    return std::this_thread::get_id() == sMainThreadId;
+}
+
+void MainThreadQueue::RunOrQueue(std::function<void()> task)
+{
+    if (IsMainThread())
+    {
+        task();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    sTasks.push_back(std::move(task));
+}
+
+std::size_t MainThreadQueue::Pump(double budgetMs)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(sMutex);
+            if (sTasks.empty())
+                return 0;
+            task = std::move(sTasks.front());
+            sTasks.pop_front();
+        }
+
+        task();
+
+        const double elapsedMs =
+            std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (elapsedMs >= budgetMs)
+            break;
+    }
+
+    return PendingCount();
+}
+
+std::size_t MainThreadQueue::PendingCount()
+{
+    std::lock_guard<std::mutex> lock(sMutex);
+    return sTasks.size();
+}
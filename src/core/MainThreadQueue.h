@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// MainThreadQueue:
+// - Work that must run on the main (GL) thread, e.g. GPU uploads requested by
+//   components that are being constructed on a worker thread.
+// - On the main thread RunOrQueue() runs the task immediately, so synchronous
+//   code paths behave exactly as before.
+// - The main loop drains the queue in small time slices with Pump().
+class MainThreadQueue
+{
+public:
+    // Record the calling thread as the main thread (call once from main()).
+    static void MarkMainThread();
+    static bool IsMainThread();
+
+    // Run now if on the main thread, otherwise queue for a later Pump().
+    static void RunOrQueue(std::function<void()> task);
+
+    // Run queued tasks in FIFO order until budgetMs is spent (at least one task
+    // runs if any are queued). Returns the number of tasks still queued.
+    static std::size_t Pump(double budgetMs);
+
+    static std::size_t PendingCount();
+};
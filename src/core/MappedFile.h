@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+// MappedFile:
+// - Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+// - The OS pages the contents in on demand; nothing is copied up front.
+// - Move-only; the mapping is released by Close() or the destructor.
+//
+// Note: the implementation includes <windows.h>, which clashes with raylib.h,
+// so MappedFile.cpp must never include raylib.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Map the file at path. Returns false (and stays closed) on failure
+    // or if the file is empty.
+    bool Open(const char* path);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const unsigned char* Data() const { return data; }
+    std::size_t Size() const { return size; }
+
+private:
+    const unsigned char* data = nullptr;
+    std::size_t          size = 0;
+
+#if defined(_WIN32)
+    void* fileHandle    = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
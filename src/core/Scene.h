@@ -13,13 +13,20 @@ public:
     // Called once after the scene is created / swapped in.
     virtual void Start() {}
 
-    // Called once per frame to update game logic.
+    // Called once per rendered frame (variable deltaTime), before the fixed steps.
+    virtual void FrameUpdate(float deltaTime) {}
+
+    // Called once per fixed simulation step to update game logic.
     virtual void Update(float deltaTime) = 0;
 
-    // Optional late update hook (order-sensitive stuff).
+    // Optional late update hook (order-sensitive stuff), once per fixed step.
     virtual void LateUpdate(float deltaTime) {}
 
     // Called once per frame to render the scene.
     // RenderPipeline already encapsulates shadow pass + final pass.
     virtual void Draw(RenderPipeline& pipeline) = 0;
+
+    // Save the scene's objects to a binary scene file. Scenes built purely
+    // in code may leave this unsupported (returns false).
+    virtual bool ExportScene(const char* path) const { return false; }
 };
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+
+// Binary scene file layout (little-endian, every section 8-byte aligned).
+// The loader maps the file and reads these records in place; the only parsing
+// is bounds validation of the header.
+//
+//   Header
+//   ObjectRecord    objects[objectCount]       depth-first pre-order, parents first
+//   ComponentRecord components[componentCount] grouped by object
+//   uint32_t        assets[assetCount]         string offsets of asset paths
+//   blob bytes                                 per-component data (POD structs)
+//   string bytes                               null-terminated names / paths
+//
+// Bump Version whenever a record or a component blob changes layout. Files from
+// MinVersion on still load; their version is passed to the component loaders
+// (SceneBlobReader::GetVersion) so they can read the older blob layouts.
+//   1: first format
+//   2: explicit flags / layer fields in the collider and MeshRenderer blobs
+namespace SceneFile
+{
+    constexpr char     Magic[4]   = { '3', 'D', 'S', 'C' };
+    constexpr uint32_t Version    = 2;
+    constexpr uint32_t MinVersion = 1;
+
+    // Sentinel parent index: attach to the root the scene is loaded under.
+    constexpr int32_t NoParent = -1;
+
+    enum ObjectFlags : uint32_t
+    {
+        ObjectActive = 1u << 0,
+    };
+
+    struct Section
+    {
+        uint32_t offset;   // from the start of the file
+        uint32_t count;    // records (or bytes for blob / string sections)
+    };
+
+    struct Header
+    {
+        char     magic[4];
+        uint32_t version;
+        uint32_t fileSize;
+        uint32_t reserved;
+        Section  objects;
+        Section  components;
+        Section  assets;
+        Section  blobs;
+        Section  strings;
+    };
+
+    struct ObjectRecord
+    {
+        int32_t  parent;          // index into objects, or NoParent
+        uint32_t name;            // string offset
+        uint32_t flags;           // ObjectFlags
+        uint32_t firstComponent;  // index into components
+        uint32_t componentCount;
+        float    position[3];     // local transform
+        float    rotation[3];
+        float    scale[3];
+    };
+
+    struct ComponentRecord
+    {
+        uint32_t tag;        // component type tag (see SceneSerializer::Register)
+        uint32_t blobOffset; // relative to the blob section
+        uint32_t blobSize;
+        uint32_t reserved;
+    };
+
+    // Four-character tag, e.g. MakeTag('M','R','N','D').
+    constexpr uint32_t MakeTag(char a, char b, char c, char d)
+    {
+        return  static_cast<uint32_t>(static_cast<unsigned char>(a))        |
+               (static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8)  |
+               (static_cast<uint32_t>(static_cast<unsigned char>(c)) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(d)) << 24);
+    }
+}
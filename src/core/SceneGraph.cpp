@@ -0,0 +1,508 @@
+#include "SceneGraph.h"
+#include "GameObject.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    // Objects per job when spreading the parallel update group over workers.
+    const std::size_t kParallelBatchSize = 64;
+
+    // Freed slots are only reused once this many are waiting, so one slot is
+    // not recycled (and its 12-bit generation wrapped) by every spawn in a burst.
+    const std::size_t kMinFreeSlots = 1024;
+
+    // Fixed steps without a change after which an object falls asleep.
+    const int kSleepSteps = 30;
+
+    // More structural changes than this before a pass: rebuild the active array
+    // from the tree instead of splicing (each splice searches and moves the array).
+    const std::size_t kMaxSplices = 32;
+}
+
+SceneGraph::SceneGraph(const std::string& rootName)
+{
+    root = CreateObject(rootName);
+}
+
+SceneGraph::~SceneGraph()
+{
+    if (root)
+        DestroyImmediate(root);
+}
+
+GameObject* SceneGraph::AllocateObject(const std::string& name)
+{
+#if CHUNK_POOL_STORAGE
+    return ChunkPool<GameObject>::Instance().Create(name);
+#else
+    return new GameObject(name);
+#endif
+}
+
+void SceneGraph::FreeObject(GameObject* obj)
+{
+#if CHUNK_POOL_STORAGE
+    ChunkPool<GameObject>::Instance().Destroy(obj);
+#else
+    delete obj;
+#endif
+}
+
+GameObject* SceneGraph::CreateObject(const std::string& name, GameObject* parent)
+{
+    uint32_t index;
+    if (!freeSlots.empty() &&
+        (freeSlots.size() >= kMinFreeSlots || slots.size() > GameObjectHandle::MaxIndex))
+    {
+        index = freeSlots.front();
+        freeSlots.pop_front();
+    }
+    else if (slots.size() <= GameObjectHandle::MaxIndex)
+    {
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    else
+    {
+        printf("SceneGraph: out of object slots, cannot create '%s'\n", name.c_str());
+        return nullptr;
+    }
+
+    GameObject* obj = AllocateObject(name);
+    obj->graph  = this;
+    obj->handle = GameObjectHandle(index, slots[index].generation);
+    slots[index].object = obj;
+    ++liveCount;
+
+    // The root is the only object without a parent.
+    if (root)
+        (parent ? parent : root)->AddChild(obj);
+
+    return obj;
+}
+
+GameObject* SceneGraph::Resolve(GameObjectHandle handle) const
+{
+    const uint32_t index = handle.Index();
+    if (handle.IsNull() || index >= slots.size())
+        return nullptr;
+
+    const ObjectSlot& slot = slots[index];
+    return slot.generation == handle.Generation() ? slot.object : nullptr;
+}
+
+void SceneGraph::Destroy(GameObject* obj)
+{
+    if (!obj || obj->graph != this || obj->destroyRequested)
+        return;
+
+    if (obj == root)
+    {
+        printf("SceneGraph: the root object cannot be destroyed\n");
+        return;
+    }
+
+    obj->destroyRequested = true;
+    destroyQueue.push_back(obj->handle);
+}
+
+void SceneGraph::Destroy(GameObjectHandle handle)
+{
+    Destroy(Resolve(handle));
+}
+
+void SceneGraph::FlushDestroyed()
+{
+    if (destroyQueue.empty())
+        return;
+
+    // OnDestroy may queue more objects; keep going until the queue is empty.
+    while (!destroyQueue.empty())
+    {
+        std::vector<GameObjectHandle> batch;
+        batch.swap(destroyQueue);
+
+        // A queued child may already be gone with its parent: Resolve() skips it.
+        for (GameObjectHandle handle : batch)
+        {
+            if (GameObject* obj = Resolve(handle))
+                DestroyImmediate(obj);
+        }
+    }
+
+    // Never leave freed objects in the pass arrays.
+    DropRemoved();
+}
+
+void SceneGraph::DestroyImmediate(GameObject* obj)
+{
+    // Collect the subtree (pre-order), unlink it, notify, then free children first.
+    std::vector<GameObject*> subtree;
+    std::vector<GameObject*> stack { obj };
+    while (!stack.empty())
+    {
+        GameObject* current = stack.back();
+        stack.pop_back();
+        subtree.push_back(current);
+        for (GameObject* child : current->children)
+            stack.push_back(child);
+    }
+
+    obj->DetachFromParent();
+
+    for (GameObject* current : subtree)
+        current->NotifyDestroy();
+
+    // Still listed ones leave the arrays in DropRemoved(), by address only.
+    for (GameObject* current : subtree)
+    {
+        if (current->listed)
+            removedObjects.push_back(current);
+    }
+
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it)
+    {
+        GameObject* current = *it;
+        ObjectSlot& slot = slots[current->handle.Index()];
+        slot.object     = nullptr;
+        slot.generation = slot.generation % GameObjectHandle::MaxGeneration + 1;
+        freeSlots.push_back(current->handle.Index());
+        --liveCount;
+
+        FreeObject(current);
+    }
+
+    if (obj == root)
+    {
+        root  = nullptr;
+        dirty = true;
+    }
+}
+
+void SceneGraph::DropRemoved()
+{
+    if (removedObjects.empty())
+        return;
+
+    // The objects are freed: compare addresses, never dereference them.
+    std::sort(removedObjects.begin(), removedObjects.end());
+    auto removed = [this](GameObject* obj)
+    {
+        return std::binary_search(removedObjects.begin(), removedObjects.end(), obj);
+    };
+    activeObjects.erase(std::remove_if(activeObjects.begin(), activeObjects.end(), removed),
+                        activeObjects.end());
+    parallelObjects.erase(std::remove_if(parallelObjects.begin(), parallelObjects.end(), removed),
+                          parallelObjects.end());
+    removedObjects.clear();
+}
+
+void SceneGraph::MarkChanged(GameObject* obj)
+{
+    if (dirty)
+        return;
+
+    // The root has no parent to splice under; past kMaxSplices a rebuild is cheaper.
+    if (obj == root || pendingChanges.size() >= kMaxSplices)
+    {
+        dirty = true;
+        pendingChanges.clear();
+        return;
+    }
+
+    pendingChanges.push_back(obj->handle);
+}
+
+void SceneGraph::Refresh()
+{
+    if (dirty)
+        Rebuild();
+    else if (!pendingChanges.empty())
+        Splice();
+
+    if (parallelDirty)
+    {
+        parallelObjects.clear();
+        for (GameObject* obj : activeObjects)
+        {
+            if (obj->HasParallelComponents())
+                parallelObjects.push_back(obj);
+        }
+        parallelDirty = false;
+    }
+}
+
+void SceneGraph::AppendSubtree(GameObject* obj, int depth, std::vector<GameObject*>& out)
+{
+    // Iterative pre-order walk. Children are pushed in reverse so they
+    // come off the stack in their original order.
+    std::vector<std::pair<GameObject*, int>> stack;
+    stack.emplace_back(obj, depth);
+
+    while (!stack.empty())
+    {
+        GameObject* current      = stack.back().first;
+        const int   currentDepth = stack.back().second;
+        stack.pop_back();
+
+        current->listed      = true;
+        current->listedDepth = currentDepth;
+        out.push_back(current);
+
+        const auto& children = current->GetChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            if ((*it)->IsActive())
+                stack.emplace_back(*it, currentDepth + 1);
+        }
+    }
+}
+
+void SceneGraph::Rebuild()
+{
+    for (GameObject* obj : activeObjects)
+        obj->listed = false;
+
+    activeObjects.clear();
+    parallelObjects.clear();
+    pendingChanges.clear();
+    dirty         = false;
+    parallelDirty = false;
+
+    if (!root || !root->IsActive())
+        return;
+
+    AppendSubtree(root, 0, activeObjects);
+    for (GameObject* obj : activeObjects)
+    {
+        if (obj->HasParallelComponents())
+            parallelObjects.push_back(obj);
+    }
+
+    // Objects that joined (or were re-activated) after the scene started
+    // get their Start() before their first Update().
+    if (started)
+    {
+        for (GameObject* obj : activeObjects)
+        {
+            if (!obj->HasStarted())
+                obj->Start();
+        }
+    }
+}
+
+void SceneGraph::Splice()
+{
+    // Start() below may record new changes for the next pass.
+    std::vector<GameObjectHandle> changes;
+    changes.swap(pendingChanges);
+
+    // Take every changed subtree out first. What stays listed did not move,
+    // so it is still in pre-order and can anchor the insertions below.
+    for (GameObjectHandle handle : changes)
+    {
+        GameObject* obj = Resolve(handle);
+        if (obj && obj->listed)
+            RemoveRange(obj);
+    }
+
+    // Put back the ones that are active under a listed parent. A changed object
+    // under a parent that is itself put back later comes along with it.
+    std::vector<GameObject*> added;
+    for (GameObjectHandle handle : changes)
+    {
+        GameObject* obj = Resolve(handle);
+        if (!obj || obj->listed || !obj->IsActive() || !obj->parent || !obj->parent->listed)
+            continue;
+
+        const std::size_t position = InsertPosition(obj);
+        const std::size_t first    = added.size();
+        AppendSubtree(obj, obj->parent->listedDepth + 1, added);
+        activeObjects.insert(activeObjects.begin() + position, added.begin() + first, added.end());
+    }
+
+    for (GameObject* obj : added)
+    {
+        if (obj->HasParallelComponents())
+            parallelObjects.push_back(obj);
+    }
+
+    // Same as Rebuild(): joined after the scene started, so start before the first Update().
+    if (started)
+    {
+        for (GameObject* obj : added)
+        {
+            if (!obj->HasStarted())
+                obj->Start();
+        }
+    }
+}
+
+void SceneGraph::RemoveRange(GameObject* obj)
+{
+    // obj's subtree is the run of entries after it that were listed deeper.
+    const auto first = std::find(activeObjects.begin(), activeObjects.end(), obj);
+    auto       last  = first + 1;
+    while (last != activeObjects.end() && (*last)->listedDepth > obj->listedDepth)
+        ++last;
+
+    bool parallel = false;
+    for (auto it = first; it != last; ++it)
+    {
+        (*it)->listed = false;
+        parallel = parallel || (*it)->HasParallelComponents();
+    }
+    activeObjects.erase(first, last);
+
+    if (parallel)
+    {
+        parallelObjects.erase(std::remove_if(parallelObjects.begin(), parallelObjects.end(),
+                                             [](const GameObject* o) { return !o->listed; }),
+                              parallelObjects.end());
+    }
+}
+
+std::size_t SceneGraph::InsertPosition(const GameObject* obj) const
+{
+    // The next listed object in pre-order: a later sibling of obj, or of one of its ancestors.
+    for (const GameObject* node = obj; node->parent; node = node->parent)
+    {
+        const auto& siblings = node->parent->children;
+        for (auto it = std::find(siblings.begin(), siblings.end(), node) + 1; it != siblings.end(); ++it)
+        {
+            if ((*it)->listed)
+                return static_cast<std::size_t>(
+                    std::find(activeObjects.begin(), activeObjects.end(), *it) - activeObjects.begin());
+        }
+    }
+    return activeObjects.size();
+}
+
+void SceneGraph::Start()
+{
+    Refresh();
+    started = true;
+
+    for (GameObject* obj : GetActiveObjects())
+    {
+        if (!obj->HasStarted())
+            obj->Start();
+    }
+}
+
+void SceneGraph::FrameUpdate(float deltaTime)
+{
+    Refresh();
+    for (GameObject* obj : GetActiveObjects())
+    {
+        if (!obj->IsSleeping())
+            obj->FrameUpdate(deltaTime);
+    }
+}
+
+void SceneGraph::Update(float deltaTime)
+{
+    Refresh();
+
+    // State at the start of this step = "previous" state for interpolation.
+    // (A sleeping object's saved state already is its current one.)
+    for (GameObject* obj : GetActiveObjects())
+    {
+        if (!obj->IsSleeping())
+            obj->GetTransform()->SaveInterpolationState();
+    }
+
+    for (GameObject* obj : GetActiveObjects())
+    {
+        if (!obj->IsSleeping())
+            obj->Update(deltaTime, UpdateGroup::MainThread);
+    }
+
+    RunParallelGroup(deltaTime, false);
+}
+
+void SceneGraph::LateUpdate(float deltaTime)
+{
+    Refresh();
+    for (GameObject* obj : GetActiveObjects())
+    {
+        if (!obj->IsSleeping())
+            obj->LateUpdate(deltaTime, UpdateGroup::MainThread);
+    }
+
+    RunParallelGroup(deltaTime, true);
+    UpdateActivity();
+
+    // Fixed point for deferred destruction: after every component has run this step.
+    FlushDestroyed();
+}
+
+void SceneGraph::RunParallelGroup(float deltaTime, bool lateUpdate)
+{
+    if (parallelObjects.empty())
+        return;
+
+    // Resolve world transforms up front so workers only ever read clean caches
+    // (lazy resolution would otherwise write shared parent caches concurrently).
+    for (GameObject* obj : parallelObjects)
+        obj->GetTransform()->GetWorldMatrix();
+
+    auto runRange = [this, deltaTime, lateUpdate](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (parallelObjects[i]->IsSleeping())
+                continue;
+            if (lateUpdate)
+                parallelObjects[i]->LateUpdate(deltaTime, UpdateGroup::Parallel);
+            else
+                parallelObjects[i]->Update(deltaTime, UpdateGroup::Parallel);
+        }
+    };
+
+    JobSystem* jobs = JobSystem::Get();
+    if (!jobs || jobs->GetWorkerCount() == 0)
+    {
+        runRange(0, parallelObjects.size());
+        return;
+    }
+
+    JobHandle handle = jobs->ParallelFor(parallelObjects.size(), kParallelBatchSize, runRange);
+    jobs->Wait(handle);
+}
+
+void SceneGraph::UpdateActivity()
+{
+    // Any change during the step woke its object and reset its count (see
+    // GameObject::WakeUp), so what is left to do is counting.
+    sleepingCount = 0;
+    for (GameObject* obj : GetActiveObjects())
+    {
+        if (!obj->sleeping && obj->CanSleep() && ++obj->idleSteps >= kSleepSteps)
+        {
+            // Fall asleep with a clean world matrix: any later change to this
+            // transform or an ancestor then reaches it and wakes it.
+            obj->GetTransform()->GetWorldMatrix();
+            obj->sleeping = true;
+        }
+        if (obj->sleeping)
+            ++sleepingCount;
+    }
+}
+
+void SceneGraph::Draw()
+{
+    Refresh();
+    for (GameObject* obj : GetActiveObjects())
+        obj->Draw();
+}
+
+void SceneGraph::DrawShadow()
+{
+    Refresh();
+    for (GameObject* obj : GetActiveObjects())
+        obj->DrawShadow();
+}
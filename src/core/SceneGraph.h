@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "GameObjectHandle.h"
+
+class GameObject;
+class PhysicsWorld;
+class PhysicsStage;
+
+// SceneGraph:
+// - Owns every GameObject of a scene (created with CreateObject) in a slot
+//   table addressed by generational handles; object memory comes from a
+//   chunked pool, so spawning / despawning reuses storage instead of fragmenting it.
+// - Destroy() is deferred: objects are queued and freed together at the end
+//   of the fixed step (LateUpdate), so nothing disappears in the middle of a pass.
+//   Hold a GameObjectHandle (not a pointer) to refer to objects that may be destroyed.
+// - Keeps a flattened, depth-first (pre-order) array of the active GameObjects,
+//   so every per-frame pass is a linear loop instead of a recursive tree walk.
+// - CreateObject / AddChild / SetActive record the changed object; at the start
+//   of the next pass its subtree is spliced out of / into the array (a search
+//   plus one move of the array tail, no tree walk above it). Many changes at
+//   once (a scene load) rebuild the array from the tree instead. Steady-state
+//   frames never touch the tree; changes made during a pass become visible
+//   from the next pass on.
+// - Update/LateUpdate run order-sensitive components on the main thread first,
+//   then spread parallel-safe components across the JobSystem workers.
+// - Objects that can sleep (see Component::CanSleep) and were left unchanged for
+//   a number of fixed steps fall asleep: the step passes skip them until they
+//   are woken. Most of a level is static, so most objects end up asleep.
+class SceneGraph
+{
+public:
+    explicit SceneGraph(const std::string& rootName = "Scene Root");
+    ~SceneGraph();
+
+    SceneGraph(const SceneGraph&) = delete;
+    SceneGraph& operator=(const SceneGraph&) = delete;
+
+    GameObject* GetRoot() const { return root; }
+
+    // Create an object under parent (the root if nullptr). Returns nullptr only
+    // if the handle index space (2^20 live objects) is exhausted.
+    GameObject* CreateObject(const std::string& name, GameObject* parent = nullptr);
+
+    // Queue obj and its descendants for destruction at the end of the current
+    // fixed step. Safe to call more than once or with stale handles.
+    void Destroy(GameObject* obj);
+    void Destroy(GameObjectHandle handle);
+
+    // The object a handle refers to, or nullptr if it has been destroyed.
+    GameObject* Resolve(GameObjectHandle handle) const;
+
+    // Free everything queued by Destroy(). Called at the end of LateUpdate().
+    void FlushDestroyed();
+
+    // Live objects including the root and objects waiting to be destroyed.
+    std::size_t GetObjectCount() const { return liveCount; }
+
+    // How many more objects CreateObject() can make before running out of slots.
+    std::size_t GetFreeObjectCapacity() const
+    {
+        return freeSlots.size() + (GameObjectHandle::MaxIndex + std::size_t(1) - slots.size());
+    }
+
+    // Active objects asleep at the end of the last fixed step.
+    std::size_t GetSleepingCount() const { return sleepingCount; }
+
+    // Collision world of this scene (not owned; may be null). Colliders
+    // register with it when they start.
+    void          SetPhysicsWorld(PhysicsWorld* world) { physicsWorld = world; }
+    PhysicsWorld* GetPhysicsWorld() const { return physicsWorld; }
+
+    // Threaded physics stage of this scene (not owned; may be null, in which
+    // case movement is simulated inline).
+    void          SetPhysicsStage(PhysicsStage* stage) { physicsStage = stage; }
+    PhysicsStage* GetPhysicsStage() const { return physicsStage; }
+
+    // Called by GameObject when obj was attached, detached or (de)activated.
+    void MarkChanged(GameObject* obj);
+
+    // Called by GameObject when obj gained parallel-safe components.
+    void MarkParallelChanged() { parallelDirty = true; }
+
+    // Active GameObjects in depth-first pre-order (parents before children).
+    const std::vector<GameObject*>& GetActiveObjects() const { return activeObjects; }
+
+    // Visit every active GameObject in depth-first pre-order.
+    template <typename Fn>
+    void ForEachActive(Fn&& fn)
+    {
+        for (GameObject* obj : GetActiveObjects())
+            fn(obj);
+    }
+
+    // Per-frame passes over the flattened array.
+    // Update() is one fixed simulation step: it first snapshots every active
+    // transform so rendering can interpolate between the last two steps.
+    void Start();
+    void FrameUpdate(float deltaTime);
+    void Update(float deltaTime);
+    void LateUpdate(float deltaTime);
+    void Draw();
+    void DrawShadow();
+
+private:
+    struct ObjectSlot
+    {
+        GameObject* object     = nullptr;
+        uint32_t    generation = 1;   // 1..MaxGeneration, never 0
+    };
+
+    GameObject*                   root = nullptr;
+    std::vector<ObjectSlot>       slots;
+    std::deque<uint32_t>          freeSlots;       // FIFO: spreads generation wrap-around
+    std::vector<GameObjectHandle> destroyQueue;
+    std::size_t                   liveCount = 0;
+    std::size_t                   sleepingCount = 0;
+    PhysicsWorld*                 physicsWorld = nullptr;
+    PhysicsStage*                 physicsStage = nullptr;
+
+    std::vector<GameObject*>      activeObjects;
+    std::vector<GameObject*>      parallelObjects; // active objects with parallel-safe components (any order)
+    std::vector<GameObjectHandle> pendingChanges;  // objects to splice at the next pass
+    std::vector<GameObject*>      removedObjects;  // freed, still in the arrays until DropRemoved()
+    bool                          dirty         = true;   // rebuild instead of splicing
+    bool                          parallelDirty = false;
+    bool                          started       = false;
+
+    // Bring activeObjects up to date if the structure changed since the last pass.
+    void Refresh();
+
+    // Rebuild activeObjects from the tree (skips inactive subtrees).
+    void Rebuild();
+
+    // Apply pendingChanges: take the changed subtrees out, then put the active
+    // ones back at their pre-order position.
+    void Splice();
+
+    // Remove obj and the entries listed below it from the arrays.
+    void RemoveRange(GameObject* obj);
+
+    // Index of the first listed object after obj's subtree in pre-order.
+    std::size_t InsertPosition(const GameObject* obj) const;
+
+    // Append obj's active subtree (pre-order) to out and mark it listed.
+    static void AppendSubtree(GameObject* obj, int depth, std::vector<GameObject*>& out);
+
+    // Drop the objects freed by DestroyImmediate() from the arrays.
+    void DropRemoved();
+
+    // Run the parallel update group of every object in parallelObjects.
+    void RunParallelGroup(float deltaTime, bool lateUpdate);
+
+    // End of a fixed step: count idle steps and put idle objects to sleep.
+    void UpdateActivity();
+
+    // Free obj and its whole subtree now (components get OnDestroy first).
+    void DestroyImmediate(GameObject* obj);
+
+    // Object storage (ChunkPool or heap, see CHUNK_POOL_STORAGE).
+    static GameObject* AllocateObject(const std::string& name);
+    static void        FreeObject(GameObject* obj);
+};
@@ -1,18 +1,39 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <type_traits>
 #include <utility>
 
+#include "JobSystem.h"
+#include "MainThreadQueue.h"
 #include "Scene.h"
 
 class RenderPipeline;
 
 /// Manages the currently active Scene.
 /// Owns a single Scene instance and forwards Start / Update / Draw calls.
+/// LoadSceneAsync() builds the next scene in the background and swaps it in
+/// once its GPU uploads have been finalized by PumpLoading().
 class SceneManager
 {
 public:
+    SceneManager() = default;
+    SceneManager(const SceneManager&) = delete;
+    SceneManager& operator=(const SceneManager&) = delete;
+
+    ~SceneManager()
+    {
+        // Never leave a worker building into a scene we are about to free.
+        if (pendingLoad)
+        {
+            if (JobSystem* jobs = JobSystem::Get())
+                jobs->Wait(pendingLoad->job);
+            while (MainThreadQueue::Pump(1000.0) > 0) {}
+        }
+    }
+
     // Sets the current scene to an already-created Scene instance.
     // Ownership is transferred into the manager.
     void SetScene(std::unique_ptr<Scene> newScene)
@@ -32,14 +53,75 @@ public:
         currentScene->Start();
     }
 
-    // Forwards per-frame update to the active scene (if any).
+    // Construct a scene of type T on a worker thread while the current scene keeps
+    // running. GPU work requested during construction is queued for the GL thread
+    // and finalized by PumpLoading(); the scene is swapped in once everything is done.
+    // Arguments are copied into the job: wrap references in std::ref().
+    // Returns false if a load is already in progress.
+    // Usage: sceneManager.LoadSceneAsync<DemoScene3D>(std::ref(pipeline));
+    template <typename T, typename... Args>
+    bool LoadSceneAsync(Args&&... args)
+    {
+        static_assert(std::is_base_of<Scene, T>::value, "T must derive from Scene");
+        if (pendingLoad)
+            return false;
+
+        auto load = std::make_shared<PendingLoad>();
+        auto build = std::bind(
+            [load](auto&... boundArgs)
+            {
+                load->scene = std::make_unique<T>(boundArgs...);
+                load->built.store(true, std::memory_order_release);
+            },
+            std::forward<Args>(args)...);
+
+        // Without worker threads, build right away (uploads still go through PumpLoading).
+        JobSystem* jobs = JobSystem::Get();
+        if (jobs && jobs->GetWorkerCount() > 0)
+            load->job = jobs->Schedule(std::move(build));
+        else
+            build();
+
+        pendingLoad = std::move(load);
+        return true;
+    }
+
+    bool IsLoading() const { return pendingLoad != nullptr; }
+
+    // Call once per frame on the main thread: runs queued GPU uploads for up to
+    // budgetMs and swaps in the pending scene once it is fully built.
+    void PumpLoading(double budgetMs = 4.0)
+    {
+        if (!pendingLoad)
+            return;
+
+        if (MainThreadQueue::Pump(budgetMs) > 0)
+            return;
+
+        // Uploads drained; the worker may still be adding components (and queueing more).
+        if (!pendingLoad->built.load(std::memory_order_acquire) || MainThreadQueue::PendingCount() > 0)
+            return;
+
+        std::unique_ptr<Scene> scene = std::move(pendingLoad->scene);
+        pendingLoad.reset();
+        SetScene(std::move(scene));
+    }
+
+    // Forwards the once-per-rendered-frame update to the active scene (if any).
+    void FrameUpdate(float deltaTime)
+    {
+        if (currentScene)
+            currentScene->FrameUpdate(deltaTime);
+    }
+
+    // Forwards a fixed simulation step to the active scene (if any).
     void Update(float deltaTime)
     {
         if (currentScene)
             currentScene->Update(deltaTime);
     }
 
-    // Forwards per-frame late update to the active scene (if any).
+    // Forwards a fixed-step late update to the active scene (if any).
     void LateUpdate(float deltaTime)
     {
         if (currentScene)
@@ -53,6 +135,21 @@ public:
             currentScene->Draw(pipeline);
     }
 
+    // Saves the active scene to a binary scene file (false if unsupported).
+    bool ExportScene(const char* path) const
+    {
+        return currentScene && currentScene->ExportScene(path);
+    }
+
 private:
-    std::unique_ptr<Scene> currentScene;
+    // Scene being built in the background (shared with the build job).
+    struct PendingLoad
+    {
+        std::unique_ptr<Scene> scene;
+        std::atomic<bool>      built { false };
+        JobHandle              job;
+    };
+
+    std::unique_ptr<Scene>       currentScene;
+    std::shared_ptr<PendingLoad> pendingLoad;
 };
@@ -0,0 +1,345 @@
+#include "SceneSerializer.h"
+
+#include "GameObject.h"
+#include "MappedFile.h"
+#include "SceneGraph.h"
+#include "Transform3D.h"
+
+#include <cstdio>
+#include <utility>
+
+namespace
+{
+    struct Registration
+    {
+        ComponentTypeId                  typeId;
+        uint32_t                         tag;
+        std::function<void(const Component&, SceneBlobWriter&)> save;
+        SceneSerializer::LoadFn          load;
+    };
+
+    std::vector<Registration> sRegistry;
+
+    const Registration* FindByType(ComponentTypeId typeId)
+    {
+        for (const Registration& entry : sRegistry)
+            if (entry.typeId == typeId)
+                return &entry;
+        return nullptr;
+    }
+
+    const Registration* FindByTag(uint32_t tag)
+    {
+        for (const Registration& entry : sRegistry)
+            if (entry.tag == tag)
+                return &entry;
+        return nullptr;
+    }
+
+    constexpr uint32_t kAlignment = 8;
+
+    void PadTo(std::vector<unsigned char>& bytes, uint32_t alignment)
+    {
+        while (bytes.size() % alignment != 0)
+            bytes.push_back(0);
+    }
+
+    template <typename T>
+    void Append(std::vector<unsigned char>& bytes, const T* values, std::size_t count)
+    {
+        const unsigned char* begin = reinterpret_cast<const unsigned char*>(values);
+        bytes.insert(bytes.end(), begin, begin + sizeof(T) * count);
+    }
+
+    // Appends a section and returns where it starts.
+    template <typename T>
+    SceneFile::Section AppendSection(std::vector<unsigned char>& file, const std::vector<T>& values)
+    {
+        PadTo(file, kAlignment);
+        SceneFile::Section section { static_cast<uint32_t>(file.size()),
+                                     static_cast<uint32_t>(values.size()) };
+        Append(file, values.data(), values.size());
+        return section;
+    }
+
+    uint32_t AddString(std::vector<char>& strings, const std::string& text)
+    {
+        const uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.insert(strings.end(), text.begin(), text.end());
+        strings.push_back('\0');
+        return offset;
+    }
+
+    void StoreVector(float (&out)[3], Vector3 v)
+    {
+        out[0] = v.x; out[1] = v.y; out[2] = v.z;
+    }
+
+    Vector3 LoadVector(const float (&in)[3])
+    {
+        return { in[0], in[1], in[2] };
+    }
+
+    // True if [offset, offset + count * stride) lies inside the file and is aligned.
+    bool SectionFits(const SceneFile::Section& section, std::size_t stride, std::size_t fileSize)
+    {
+        const uint64_t end = static_cast<uint64_t>(section.offset) +
+                             static_cast<uint64_t>(section.count) * stride;
+        return section.offset % kAlignment == 0 &&
+               section.offset >= sizeof(SceneFile::Header) &&
+               end <= fileSize;
+    }
+}
+
+uint32_t SceneBlobWriter::AddAsset(const std::string& path)
+{
+    for (std::size_t i = 0; i < assets.size(); ++i)
+        if (assets[i] == path)
+            return static_cast<uint32_t>(i);
+
+    assets.push_back(path);
+    return static_cast<uint32_t>(assets.size() - 1);
+}
+
+const char* SceneBlobReader::GetAsset(uint32_t index) const
+{
+    return index < assetCount ? strings + assets[index] : nullptr;
+}
+
+void SceneSerializer::RegisterType(ComponentTypeId typeId, uint32_t tag,
+                                   ErasedSaveFn save, LoadFn load)
+{
+    for (Registration& entry : sRegistry)
+    {
+        if (entry.typeId == typeId || entry.tag == tag)
+        {
+            entry = { typeId, tag, std::move(save), load };
+            return;
+        }
+    }
+
+    sRegistry.push_back({ typeId, tag, std::move(save), load });
+}
+
+bool SceneSerializer::Export(GameObject& root, const char* path)
+{
+    std::vector<SceneFile::ObjectRecord>    objects;
+    std::vector<SceneFile::ComponentRecord> components;
+    std::vector<unsigned char>              blobs;
+    std::vector<std::string>                assetPaths;
+    std::vector<char>                       strings;
+
+    const ComponentTypeId transformId = ComponentType::Id<Transform3D>();
+
+    // Depth-first pre-order, so every parent is written before its children.
+    std::vector<std::pair<GameObject*, int32_t>> stack;
+    const auto& rootChildren = root.GetChildren();
+    for (auto it = rootChildren.rbegin(); it != rootChildren.rend(); ++it)
+        stack.emplace_back(*it, SceneFile::NoParent);
+
+    while (!stack.empty())
+    {
+        GameObject* obj    = stack.back().first;
+        const int32_t parent = stack.back().second;
+        stack.pop_back();
+
+        const int32_t index = static_cast<int32_t>(objects.size());
+        Transform3D*  t     = obj->GetTransform();
+
+        SceneFile::ObjectRecord record {};
+        record.parent         = parent;
+        record.name           = AddString(strings, obj->GetName());
+        record.flags          = obj->IsActive() ? SceneFile::ObjectActive : 0u;
+        record.firstComponent = static_cast<uint32_t>(components.size());
+        StoreVector(record.position, t->GetPosition());
+        StoreVector(record.rotation, t->GetRotation());
+        StoreVector(record.scale,    t->GetScale());
+
+        obj->ForEachComponent([&](ComponentTypeId typeId, const Component& component)
+        {
+            if (typeId == transformId)
+                return;
+
+            const Registration* entry = FindByType(typeId);
+            if (!entry)
+            {
+                printf("SceneSerializer: '%s' has an unregistered component (type %u), not exported\n",
+                       obj->GetName().c_str(), static_cast<unsigned>(typeId));
+                return;
+            }
+
+            PadTo(blobs, kAlignment);
+            const uint32_t start = static_cast<uint32_t>(blobs.size());
+            SceneBlobWriter writer(blobs, assetPaths);
+            entry->save(component, writer);
+
+            components.push_back({ entry->tag, start, static_cast<uint32_t>(blobs.size()) - start, 0 });
+        });
+
+        record.componentCount = static_cast<uint32_t>(components.size()) - record.firstComponent;
+        objects.push_back(record);
+
+        const auto& children = obj->GetChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+            stack.emplace_back(*it, index);
+    }
+
+    std::vector<uint32_t> assets;
+    assets.reserve(assetPaths.size());
+    for (const std::string& asset : assetPaths)
+        assets.push_back(AddString(strings, asset));
+    if (strings.empty())
+        strings.push_back('\0');
+
+    // Assemble the file image: header first, patched once the offsets are known.
+    std::vector<unsigned char> file(sizeof(SceneFile::Header), 0);
+
+    SceneFile::Header header {};
+    std::memcpy(header.magic, SceneFile::Magic, sizeof(header.magic));
+    header.version    = SceneFile::Version;
+    header.objects    = AppendSection(file, objects);
+    header.components = AppendSection(file, components);
+    header.assets     = AppendSection(file, assets);
+    header.blobs      = AppendSection(file, blobs);
+    header.strings    = AppendSection(file, strings);
+    header.fileSize   = static_cast<uint32_t>(file.size());
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    FILE* out = fopen(path, "wb");
+    if (!out)
+    {
+        printf("SceneSerializer: cannot write '%s'\n", path);
+        return false;
+    }
+
+    const bool written = fwrite(file.data(), 1, file.size(), out) == file.size();
+    fclose(out);
+    return written;
+}
+
+bool SceneSerializer::Load(const char* path, GameObject& root, const SceneLoadContext& context,
+                           std::vector<GameObject*>* outObjects)
+{
+    using namespace SceneFile;
+
+    SceneGraph* graph = root.GetSceneGraph();
+    if (!graph)
+        return false;
+
+    MappedFile file;
+    if (!file.Open(path))
+        return false;
+
+    const unsigned char* base = file.Data();
+    const std::size_t    size = file.Size();
+
+    // --- Validate everything up front so instantiation can trust the records ---
+    if (size < sizeof(Header))
+        return false;
+
+    Header header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (std::memcmp(header.magic, Magic, sizeof(header.magic)) != 0 ||
+        header.version < MinVersion || header.version > Version || header.fileSize != size)
+    {
+        printf("SceneSerializer: '%s' is not a version %u..%u scene file\n", path, MinVersion, Version);
+        return false;
+    }
+
+    if (!SectionFits(header.objects,    sizeof(ObjectRecord),    size) ||
+        !SectionFits(header.components, sizeof(ComponentRecord), size) ||
+        !SectionFits(header.assets,     sizeof(uint32_t),        size) ||
+        !SectionFits(header.blobs,      1,                       size) ||
+        !SectionFits(header.strings,    1,                       size) ||
+        header.strings.count == 0 ||
+        base[header.strings.offset + header.strings.count - 1] != '\0')
+    {
+        printf("SceneSerializer: '%s' is corrupt (bad section table)\n", path);
+        return false;
+    }
+
+    const ObjectRecord*    objects    = reinterpret_cast<const ObjectRecord*>(base + header.objects.offset);
+    const ComponentRecord* components = reinterpret_cast<const ComponentRecord*>(base + header.components.offset);
+    const uint32_t*        assets     = reinterpret_cast<const uint32_t*>(base + header.assets.offset);
+    const unsigned char*   blobs      = base + header.blobs.offset;
+    const char*            strings    = reinterpret_cast<const char*>(base + header.strings.offset);
+
+    // The string section ends in '\0', so any in-range offset is a terminated string.
+    for (uint32_t i = 0; i < header.assets.count; ++i)
+        if (assets[i] >= header.strings.count)
+            return false;
+
+    for (uint32_t i = 0; i < header.objects.count; ++i)
+    {
+        const ObjectRecord& record = objects[i];
+        const uint64_t componentEnd = static_cast<uint64_t>(record.firstComponent) + record.componentCount;
+        if (record.name >= header.strings.count ||
+            componentEnd > header.components.count ||
+            (record.parent != NoParent && (record.parent < 0 || static_cast<uint32_t>(record.parent) >= i)))
+        {
+            printf("SceneSerializer: '%s' is corrupt (object %u)\n", path, i);
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < header.components.count; ++i)
+    {
+        const uint64_t blobEnd = static_cast<uint64_t>(components[i].blobOffset) + components[i].blobSize;
+        if (blobEnd > header.blobs.count)
+        {
+            printf("SceneSerializer: '%s' is corrupt (component %u)\n", path, i);
+            return false;
+        }
+    }
+
+    // Checked here so CreateObject cannot fail halfway through instantiation.
+    if (graph->GetFreeObjectCapacity() < header.objects.count)
+    {
+        printf("SceneSerializer: '%s' has %u objects, more than the scene has room for\n",
+               path, header.objects.count);
+        return false;
+    }
+
+    // --- Instantiate in one pass: records are pre-order, so parents already exist ---
+    std::vector<GameObject*> created;
+    created.reserve(header.objects.count);
+
+    for (uint32_t i = 0; i < header.objects.count; ++i)
+    {
+        const ObjectRecord& record = objects[i];
+
+        GameObject* parent = record.parent == NoParent ? &root : created[record.parent];
+        GameObject* obj    = graph->CreateObject(strings + record.name, parent);
+
+        Transform3D* t = obj->GetTransform();
+        t->SetPosition(LoadVector(record.position));
+        t->SetRotation(LoadVector(record.rotation));
+        t->SetScale(LoadVector(record.scale));
+        if (!(record.flags & ObjectActive))
+            obj->SetActive(false);
+
+        for (uint32_t c = 0; c < record.componentCount; ++c)
+        {
+            const ComponentRecord& component = components[record.firstComponent + c];
+            const Registration* entry = FindByTag(component.tag);
+            if (!entry)
+            {
+                printf("SceneSerializer: unknown component tag 0x%08X on '%s', skipped\n",
+                       component.tag, strings + record.name);
+                continue;
+            }
+
+            SceneBlobReader reader(blobs + component.blobOffset, component.blobSize,
+                                   assets, header.assets.count, strings, header.version, context);
+            entry->load(*obj, reader);
+        }
+
+        created.push_back(obj);
+    }
+
+    if (outObjects)
+        outObjects->insert(outObjects->end(), created.begin(), created.end());
+
+    return true;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Component.h"
+#include "ComponentType.h"
+#include "SceneFile.h"
+#include "raylib.h"
+
+class GameObject;
+class SceneGraph;
+
+// Runtime objects a component loader may need that a file cannot store.
+struct SceneLoadContext
+{
+    SceneGraph* graph          = nullptr;
+    Shader*     lightingShader = nullptr;
+    Shader*     shadowShader   = nullptr;
+};
+
+// Appends one component's data to the blob section during export.
+// Blobs are plain structs written as raw bytes (see SceneFile.h).
+class SceneBlobWriter
+{
+public:
+    template <typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "scene blobs must be POD");
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+        blob.insert(blob.end(), bytes, bytes + sizeof(T));
+    }
+
+    // Reference an external asset (model, texture...) by path. Returns its index
+    // in the file's asset table; identical paths share one entry.
+    uint32_t AddAsset(const std::string& path);
+
+private:
+    friend class SceneSerializer;
+
+    SceneBlobWriter(std::vector<unsigned char>& blobBytes, std::vector<std::string>& assetPaths)
+        : blob(blobBytes), assets(assetPaths) {}
+
+    std::vector<unsigned char>& blob;
+    std::vector<std::string>&   assets;
+};
+
+// Reads one component's blob straight out of the mapped file.
+class SceneBlobReader
+{
+public:
+    // Copy the next sizeof(T) bytes into value. Returns false if the blob is too short.
+    template <typename T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "scene blobs must be POD");
+        if (size - cursor < sizeof(T))
+            return false;
+        std::memcpy(&value, data + cursor, sizeof(T));
+        cursor += static_cast<uint32_t>(sizeof(T));
+        return true;
+    }
+
+    // Asset path by index, or nullptr if the index is out of range.
+    const char* GetAsset(uint32_t index) const;
+
+    const SceneLoadContext& GetContext() const { return context; }
+
+    // Version of the file being read (SceneFile::MinVersion..Version).
+    uint32_t GetVersion() const { return version; }
+
+private:
+    friend class SceneSerializer;
+
+    SceneBlobReader(const unsigned char* blobData, uint32_t blobSize,
+                    const uint32_t* assetTable, uint32_t assetCount,
+                    const char* stringTable, uint32_t fileVersion,
+                    const SceneLoadContext& loadContext)
+        : data(blobData), size(blobSize), assets(assetTable), assetCount(assetCount),
+          strings(stringTable), version(fileVersion), context(loadContext) {}
+
+    const unsigned char*    data;
+    uint32_t                size;
+    uint32_t                cursor = 0;
+    const uint32_t*         assets;
+    uint32_t                assetCount;
+    const char*             strings;
+    uint32_t                version;
+    const SceneLoadContext& context;
+};
+
+// SceneSerializer:
+// - Export() writes a GameObject hierarchy to the binary scene format.
+// - Load() maps a scene file and instantiates all of its objects in one pass
+//   under a given root (no text parsing, objects come from the scene's pool).
+// - Components opt in with Register<T>(): a stable four-character tag plus a
+//   save / load function pair. Unregistered components are not exported
+//   (Transform3D is stored in the object record itself).
+class SceneSerializer
+{
+public:
+    using LoadFn = void (*)(GameObject& owner, SceneBlobReader& reader);
+
+    template <typename T>
+    using SaveFn = void (*)(const T& component, SceneBlobWriter& writer);
+
+    // Register component type T under tag. Call before the first Export / Load.
+    template <typename T>
+    static void Register(uint32_t tag, SaveFn<T> save, LoadFn load)
+    {
+        RegisterType(ComponentType::Id<T>(), tag,
+                     [save](const Component& component, SceneBlobWriter& writer)
+                     {
+                         save(static_cast<const T&>(component), writer);
+                     },
+                     load);
+    }
+
+    // Write the children of root (not root itself) and everything below them.
+    static bool Export(GameObject& root, const char* path);
+
+    // Instantiate the file's objects as children of root (which must belong to a
+    // SceneGraph). The created objects are appended to outObjects (pre-order) if
+    // given. Returns false if the file is missing, has an unsupported version, fails
+    // validation or holds more objects than the scene has free slots for;
+    // nothing is created then (all of this is checked before the first object).
+    static bool Load(const char* path, GameObject& root, const SceneLoadContext& context,
+                     std::vector<GameObject*>* outObjects = nullptr);
+
+private:
+    using ErasedSaveFn = std::function<void(const Component&, SceneBlobWriter&)>;
+
+    static void RegisterType(ComponentTypeId typeId, uint32_t tag,
+                             ErasedSaveFn save, LoadFn load);
+};
@@ -1,46 +1,193 @@
 #include "Transform3D.h"
+#include "GameObject.h"
 #include "raymath.h"
 
-Vector3 Transform3D::Forward() const
+#include <algorithm>
+
+Transform3D::~Transform3D()
 {
-    // Convention: rotation.x = pitch, rotation.y = yaw, degrees
-    float pitch = rotation.x * DEG2RAD;
-    float yaw   = rotation.y * DEG2RAD;
+    // Detach from the hierarchy so nobody keeps a dangling pointer to us.
+    for (Transform3D* child : children)
+        child->parent = nullptr;
+    children.clear();
 
-    Vector3 f;
-    f.x = cosf(pitch) * sinf(yaw);
-    f.y = sinf(pitch);
-    f.z = cosf(pitch) * cosf(yaw);
+    SetParent(nullptr);
+}
 
-    return Vector3Normalize(f);
+namespace
+{
+    bool SameVector(Vector3 a, Vector3 b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    // Same composition as GetLocalMatrix(), for arbitrary (interpolated) values.
+    Matrix ComposeLocal(Vector3 position, Vector3 rotation, Vector3 scale)
+    {
+        // Convention: rotation.x = pitch, rotation.y = yaw, rotation.z = roll, degrees.
+        // Positive pitch looks up, so +Z is rotated by -pitch around X before yaw.
+        Matrix matScale = MatrixScale(scale.x, scale.y, scale.z);
+        Matrix matRot   = MatrixMultiply(
+            MatrixMultiply(MatrixRotateZ(rotation.z * DEG2RAD),
+                           MatrixRotateX(-rotation.x * DEG2RAD)),
+            MatrixRotateY(rotation.y * DEG2RAD));
+        Matrix matTrans = MatrixTranslate(position.x, position.y, position.z);
+
+        return MatrixMultiply(MatrixMultiply(matScale, matRot), matTrans);
+    }
 }
 
-Vector3 Transform3D::Right() const
+void Transform3D::MarkLocalDirty()
+{
+    localDirty = true;
+    if (gameObject)
+        gameObject->WakeUp();
+    MarkWorldDirty();
+}
+
+void Transform3D::MarkWorldDirty()
+{
+    // Already dirty means the whole subtree is dirty too: stop here. (Objects
+    // only fall asleep with a clean world matrix, so none sleeps below.)
+    if (worldDirty)
+        return;
+
+    worldDirty = true;
+    if (gameObject)
+        gameObject->WakeUp();
+    for (Transform3D* child : children)
+        child->MarkWorldDirty();
+}
+
+void Transform3D::SetParent(Transform3D* newParent)
+{
+    if (newParent == parent || newParent == this)
+        return;
+
+    if (parent)
+    {
+        auto& siblings = parent->children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+
+    parent = newParent;
+    if (parent)
+        parent->children.push_back(this);
+
+    MarkWorldDirty();
+}
+
+const Matrix& Transform3D::GetLocalMatrix() const
+{
+    if (localDirty)
+    {
+        localMatrix = ComposeLocal(position, rotation, scale);
+        localDirty  = false;
+    }
+
+    return localMatrix;
+}
+
+void Transform3D::UpdateWorld() const
+{
+    const Matrix& local = GetLocalMatrix();
+    worldMatrix = parent ? MatrixMultiply(local, parent->GetWorldMatrix()) : local;
+
+    // Basis = transformed local axes. Forward is local +Z, up is local +Y and
+    // right is local -X (matches the old cross(forward, worldUp) convention).
+    forward = Vector3Normalize({ worldMatrix.m8, worldMatrix.m9, worldMatrix.m10 });
+    up      = Vector3Normalize({ worldMatrix.m4, worldMatrix.m5, worldMatrix.m6 });
+    right   = Vector3Normalize({ -worldMatrix.m0, -worldMatrix.m1, -worldMatrix.m2 });
+
+    worldDirty = false;
+    ++worldVersion;
+}
+
+const Matrix& Transform3D::GetWorldMatrix() const
+{
+    if (worldDirty)
+        UpdateWorld();
+    return worldMatrix;
+}
+
+Vector3 Transform3D::GetWorldPosition() const
+{
+    const Matrix& world = GetWorldMatrix();
+    return { world.m12, world.m13, world.m14 };
+}
+
+uint32_t Transform3D::GetWorldVersion() const
 {
-    // Right = cross(forward, worldUp)
-    const Vector3 worldUp { 0.0f, 1.0f, 0.0f };
-    Vector3 f = Forward();
-    Vector3 r = Vector3CrossProduct(f, worldUp);
+    if (worldDirty)
+        UpdateWorld();
+    return worldVersion;
+}
 
-    // If forward is almost parallel to up, this can go near-zero;
-    // in practice for FPS-style this is fine.
-    if (Vector3Length(r) < 0.0001f)
-        return { 1.0f, 0.0f, 0.0f }; // fallback
+void Transform3D::SaveInterpolationState()
+{
+    prevPosition = position;
+    prevRotation = rotation;
+    prevScale    = scale;
+    hasPrevState = true;
+}
+
+bool Transform3D::MovedSinceSave() const
+{
+    return hasPrevState &&
+           !(SameVector(prevPosition, position) &&
+             SameVector(prevRotation, rotation) &&
+             SameVector(prevScale, scale));
+}
 
-    return Vector3Normalize(r);
+Matrix Transform3D::GetInterpolatedWorldMatrix(float alpha) const
+{
+    // Objects that did not move this step reuse the cached local matrix.
+    Matrix local;
+    if (MovedSinceSave())
+    {
+        local = ComposeLocal(Vector3Lerp(prevPosition, position, alpha),
+                             Vector3Lerp(prevRotation, rotation, alpha),
+                             Vector3Lerp(prevScale, scale, alpha));
+    }
+    else
+    {
+        local = GetLocalMatrix();
+    }
+
+    return parent ? MatrixMultiply(local, parent->GetInterpolatedWorldMatrix(alpha)) : local;
+}
+
+Vector3 Transform3D::GetInterpolatedWorldPosition(float alpha) const
+{
+    Matrix world = GetInterpolatedWorldMatrix(alpha);
+    return { world.m12, world.m13, world.m14 };
+}
+
+Vector3 Transform3D::Forward() const
+{
+    if (worldDirty)
+        UpdateWorld();
+    return forward;
+}
+
+Vector3 Transform3D::Right() const
+{
+    if (worldDirty)
+        UpdateWorld();
+    return right;
 }
 
 Vector3 Transform3D::Up() const
 {
-    Vector3 f = Forward();
-    Vector3 r = Right();
-    Vector3 u = Vector3CrossProduct(r, f);
-    return Vector3Normalize(u);
+    if (worldDirty)
+        UpdateWorld();
+    return up;
 }
 
 void Transform3D::Translate(Vector3 offset)
 {
     position = Vector3Add(position, offset);
+    MarkLocalDirty();
 }
 
 void Transform3D::Rotate(Vector3 eulerDelta)
@@ -48,4 +195,5 @@ void Transform3D::Rotate(Vector3 eulerDelta)
     rotation.x += eulerDelta.x;
     rotation.y += eulerDelta.y;
     rotation.z += eulerDelta.z;
+    MarkLocalDirty();
 }
@@ -1,8 +1,18 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "Component.h"
 #include "raylib.h"
 
+// Transform3D:
+// - Stores local position / euler rotation / scale relative to the parent transform.
+// - Caches the local and world matrices plus the world-space basis vectors.
+// - Changing a transform marks it and its descendants dirty; matrices are
+//   rebuilt lazily the next time they are read.
+// - Keeps the local state from the start of the current fixed step so rendering
+//   can interpolate between the last two simulation states.
 class Transform3D : public Component
 {
 private:
@@ -10,17 +20,80 @@ private:
     Vector3 rotation { 0.0f, 0.0f, 0.0f }; // pitch (x), yaw (y), roll (z) in degrees
     Vector3 scale    { 1.0f, 1.0f, 1.0f };
 
+    // Hierarchy (mirrors GameObject parent/children).
+    Transform3D*              parent = nullptr;
+    std::vector<Transform3D*> children;
+
+    // Lazily rebuilt caches. Invariant: if a transform is world-dirty,
+    // all of its descendants are world-dirty too.
+    mutable Matrix  localMatrix {};
+    mutable Matrix  worldMatrix {};
+    mutable Vector3 forward { 0.0f, 0.0f, 1.0f };
+    mutable Vector3 right   { -1.0f, 0.0f, 0.0f };
+    mutable Vector3 up      { 0.0f, 1.0f, 0.0f };
+    mutable bool    localDirty = true;
+    mutable bool    worldDirty = true;
+    mutable uint32_t worldVersion = 0;   // bumped every time the world matrix is rebuilt
+
+    // Local state at the start of the current fixed step (render interpolation).
+    Vector3 prevPosition { 0.0f, 0.0f, 0.0f };
+    Vector3 prevRotation { 0.0f, 0.0f, 0.0f };
+    Vector3 prevScale    { 1.0f, 1.0f, 1.0f };
+    bool    hasPrevState = false;
+
+    // True if the local state changed since the last SaveInterpolationState().
+    bool MovedSinceSave() const;
+
+    // Local values changed: local + world caches of this subtree are stale.
+    void MarkLocalDirty();
+
+    // Parent moved: world caches of this subtree are stale.
+    void MarkWorldDirty();
+
+    // Rebuild world matrix and basis (resolving the parent chain first).
+    void UpdateWorld() const;
+
 public:
+    ~Transform3D();
+
     Vector3 GetPosition() const { return position; }
-    void SetPosition(Vector3 p) { position = p; }
+    void SetPosition(Vector3 p) { position = p; MarkLocalDirty(); }
 
     Vector3 GetRotation() const { return rotation; }
-    void SetRotation(Vector3 r) { rotation = r; }
+    void SetRotation(Vector3 r) { rotation = r; MarkLocalDirty(); }
 
     Vector3 GetScale() const { return scale; }
-    void SetScale(Vector3 s) { scale = s; }
+    void SetScale(Vector3 s) { scale = s; MarkLocalDirty(); }
+
+    // Hierarchy. SetParent keeps the local values (the object moves with its new parent).
+    Transform3D* GetParent() const { return parent; }
+    void SetParent(Transform3D* newParent);
+    const std::vector<Transform3D*>& GetChildren() const { return children; }
+
+    // Cached matrices: local = scale * rotation * translation, world = local * parent world.
+    const Matrix& GetLocalMatrix() const;
+    const Matrix& GetWorldMatrix() const;
+
+    // World-space position (translation of the world matrix).
+    Vector3 GetWorldPosition() const;
+
+    // Changes whenever the world matrix changes (resolves a dirty cache first).
+    // Lets systems like PhysicsWorld skip transforms that did not move.
+    uint32_t GetWorldVersion() const;
+
+    // Snapshot the current local state as the step's starting state.
+    // Called by SceneGraph at the start of every fixed simulation step.
+    void SaveInterpolationState();
+
+    // Drop the snapshot (e.g. after a teleport) so rendering snaps to the current state.
+    void ResetInterpolation() { hasPrevState = false; }
+
+    // World matrix / position blended between the saved and current state.
+    // alpha = 0 gives the saved state, alpha = 1 the current one.
+    Matrix  GetInterpolatedWorldMatrix(float alpha) const;
+    Vector3 GetInterpolatedWorldPosition(float alpha) const;
 
-    // Direction vectors in world space
+    // Direction vectors in world space (cached, normalized)
     Vector3 Forward() const;
     Vector3 Right() const;
     Vector3 Up() const;
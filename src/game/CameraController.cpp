@@ -20,7 +20,7 @@ void CameraController::Start()
     // DisableCursor(); // Example: raylib call, if you decide to lock the cursor.
 }
 
-void CameraController::Update(float /*deltaTime*/)
+void CameraController::FrameUpdate(float /*deltaTime*/)
 {
     // If we somehow lost the transform, try to reacquire once.
     if (!transform && gameObject)
@@ -5,7 +5,7 @@
 class Transform3D;
 
 // CameraController:
-// - Reads mouse input each frame.
+// - Reads mouse input once per rendered frame (FrameUpdate), independent of the sim rate.
 // - Maintains yaw (Y) and pitch (X) in degrees.
 // - Writes the result into the attached Transform3D.
 // - Does NOT own or feed a Camera3D directly; it only rotates the transform.
@@ -25,9 +25,11 @@ public:
     {
     }
 
+    float GetSensitivity() const { return mouseSensitivity; }
+
     // Cache the Transform3D and initialize yaw/pitch from its current rotation.
     void Start() override;
 
     // Read mouse input, update yaw/pitch, and write back to Transform3D.
-    void Update(float deltaTime) override;
+    void FrameUpdate(float deltaTime) override;
 };
@@ -2,33 +2,106 @@
 
 #include "RenderPipeline.h"
 #include "GameObject.h"
+#include "SceneGraph.h"
 #include "Transform3D.h"
 #include "CameraComponent.h"
 #include "CameraController.h"
 #include "PlayerController.h"
 #include "BoxCollider.h"
+#include "MeshCollider.h"
 #include "MeshRenderer.h"
 #include "MeshFilter.h"
 #include "LightComponent.h"
 #include "ShadowMap.h"
+#include "SceneComponents.h"
+#include "SceneSerializer.h"
+#include "PhysicsWorld.h"
+#include "PhysicsStage.h"
 
 #include "raylib.h"
 
-DemoScene3D::DemoScene3D(RenderPipeline& pipelineRef)
+#include <cstdio>
+#include <vector>
+
+DemoScene3D::DemoScene3D(RenderPipeline& pipelineRef, const char* scenePath)
     : pipeline(pipelineRef)
 {
     // Build the GameObject graph and cache references.
-    BuildSceneGraph();
+    if (!scenePath || !LoadSceneGraph(scenePath))
+        BuildSceneGraph();
+
+    // Colliders join the world when the scene starts. A handful of static boxes
+    // of mixed sizes: the tree fits best (SpatialHash suits crowds of agents).
+    physicsWorld = std::make_unique<PhysicsWorld>(BroadphaseType::DynamicTree);
+    sceneGraph->SetPhysicsWorld(physicsWorld.get());
+
+    // The player's movement runs against the world while the frame renders.
+    physicsStage = std::make_unique<PhysicsStage>(*physicsWorld);
+    sceneGraph->SetPhysicsStage(physicsStage.get());
+}
+
+DemoScene3D::~DemoScene3D()
+{
+    // Let the physics worker finish before the objects it reads go away.
+    if (physicsStage)
+        physicsStage->Sync();
+}
+
+bool DemoScene3D::LoadSceneGraph(const char* scenePath)
+{
+    RegisterSceneComponents();
+
+    auto graph = std::make_unique<SceneGraph>();
+
+    SceneLoadContext context;
+    context.graph          = graph.get();
+    context.lightingShader = pipeline.GetLightingShader();
+    context.shadowShader   = pipeline.GetShadowShader();
+
+    std::vector<GameObject*> objects;
+    if (!SceneSerializer::Load(scenePath, *graph->GetRoot(), context, &objects))
+        return false;
+
+    // Find the objects the pipeline needs (first of each kind wins).
+    GameObject* loadedPlayer = nullptr;
+    GameObject* loadedSun    = nullptr;
+    for (GameObject* obj : objects)
+    {
+        if (!loadedPlayer && obj->GetComponent<CameraComponent>())
+            loadedPlayer = obj;
+        if (!loadedSun && obj->GetComponent<LightComponent>() && obj->GetComponent<ShadowMap>())
+            loadedSun = obj;
+    }
+
+    if (!loadedPlayer || !loadedSun)
+    {
+        printf("DemoScene3D: '%s' has no camera / light + shadow map, using built-in scene\n", scenePath);
+        return false;
+    }
+
+    sceneGraph = std::move(graph);
+    player     = loadedPlayer->GetHandle();
+    sun        = loadedSun->GetHandle();
+    return true;
+}
+
+bool DemoScene3D::ExportScene(const char* path) const
+{
+    if (!sceneGraph)
+        return false;
+
+    RegisterSceneComponents();
+    return SceneSerializer::Export(*sceneGraph->GetRoot(), path);
 }
 
 void DemoScene3D::BuildSceneGraph()
 {
-    sceneRoot = std::make_shared<GameObject>("Scene Root");
+    sceneGraph = std::make_unique<SceneGraph>();
 
     // -------------------
     // Player
     // -------------------
-    auto playerGO = std::make_shared<GameObject>("Player");
+    GameObject* playerGO = sceneGraph->CreateObject("Player");
     playerGO->GetTransform()->SetPosition({ 0, 1, 0 });
     playerGO->AddComponent<CameraController>(0.15f);
     playerGO->AddComponent<CameraComponent>();
@@ -37,60 +110,56 @@ void DemoScene3D::BuildSceneGraph()
         Vector3{ 0, 0, 0 },             // offset
         false                           // show collider
     );
-    playerGO->AddComponent<PlayerController>(5.0f, sceneRoot.get());
-    sceneRoot->AddChild(playerGO);
+    playerGO->AddComponent<PlayerController>(5.0f, sceneGraph.get());
 
-    player = playerGO.get();
-    camera = player->GetComponent<CameraComponent>();
+    player = playerGO->GetHandle();
 
     // -------------------
     // Ground
     // -------------------
-    auto ground = std::make_shared<GameObject>("Ground");
+    // Ground, obstacles and walls never move: their colliders are static, and
+    // they cast into the cached static shadow layer.
+    GameObject* ground = sceneGraph->CreateObject("Ground");
     ground->GetTransform()->SetPosition({ 0, -0.5f, 0 });
     ground->GetTransform()->SetScale({ 20, 1, 20 });
-    ground->AddComponent<MeshRenderer>(MeshRenderer::CUBE, GRAY);
-    ground->AddComponent<BoxCollider>(Vector3{ 20, 1, 20 }, Vector3{ 0, 0, 0 }, false);
-    sceneRoot->AddChild(ground);
+    ground->AddComponent<MeshRenderer>(MeshRenderer::CUBE, GRAY)->SetStaticShadowCaster(true);
+    ground->AddComponent<BoxCollider>(Vector3{ 20, 1, 20 }, Vector3{ 0, 0, 0 }, false)->SetStatic(true);
 
     // -------------------
     // Obstacles
     // -------------------
     for (int i = 0; i < 5; ++i)
     {
-        auto cube = std::make_shared<GameObject>("Cube_" + std::to_string(i));
+        GameObject* cube = sceneGraph->CreateObject("Cube_" + std::to_string(i));
         float x = (i - 2) * 3.0f;
         cube->GetTransform()->SetPosition({ x, 0.75f, -5 });
         cube->GetTransform()->SetScale({ 2, 1.5f, 2 });
 
         Color c = { static_cast<unsigned char>(50 + i * 40), 100, 150, 255 };
 
-        cube->AddComponent<MeshRenderer>(MeshRenderer::CUBE, c);
-        cube->AddComponent<BoxCollider>(Vector3{ 2, 1.5f, 2 }, Vector3{ 0, 0, 0 }, false);
-        sceneRoot->AddChild(cube);
+        cube->AddComponent<MeshRenderer>(MeshRenderer::CUBE, c)->SetStaticShadowCaster(true);
+        cube->AddComponent<BoxCollider>(Vector3{ 2, 1.5f, 2 }, Vector3{ 0, 0, 0 }, false)->SetStatic(true);
     }
 
     // -------------------
     // Walls
     // -------------------
-    auto wall1 = std::make_shared<GameObject>("Wall1");
+    GameObject* wall1 = sceneGraph->CreateObject("Wall1");
     wall1->GetTransform()->SetPosition({ 10, 2, 0 });
     wall1->GetTransform()->SetScale({ 1, 4, 20 });
-    wall1->AddComponent<MeshRenderer>(MeshRenderer::CUBE, GRAY);
-    wall1->AddComponent<BoxCollider>(Vector3{ 1, 4, 20 }, Vector3{ 0, 0, 0 }, false);
-    sceneRoot->AddChild(wall1);
+    wall1->AddComponent<MeshRenderer>(MeshRenderer::CUBE, GRAY)->SetStaticShadowCaster(true);
+    wall1->AddComponent<BoxCollider>(Vector3{ 1, 4, 20 }, Vector3{ 0, 0, 0 }, false)->SetStatic(true);
 
-    auto wall2 = std::make_shared<GameObject>("Wall2");
+    GameObject* wall2 = sceneGraph->CreateObject("Wall2");
     wall2->GetTransform()->SetPosition({ -10, 2, 0 });
     wall2->GetTransform()->SetScale({ 1, 4, 20 });
-    wall2->AddComponent<MeshRenderer>(MeshRenderer::CUBE, GRAY);
-    wall2->AddComponent<BoxCollider>(Vector3{ 1, 4, 20 }, Vector3{ 0, 0, 0 }, false);
-    sceneRoot->AddChild(wall2);
+    wall2->AddComponent<MeshRenderer>(MeshRenderer::CUBE, GRAY)->SetStaticShadowCaster(true);
+    wall2->AddComponent<BoxCollider>(Vector3{ 1, 4, 20 }, Vector3{ 0, 0, 0 }, false)->SetStatic(true);
 
     // -------------------
     // 3D Model GameObject
     // -------------------
-    auto modelGO = std::make_shared<GameObject>("ImportedModel");
+    GameObject* modelGO = sceneGraph->CreateObject("ImportedModel");
 
     // Position it somewhere visible
     modelGO->GetTransform()->SetPosition({ 0.0f, 0.0f, -3.0f });
@@ -103,59 +172,68 @@ void DemoScene3D::BuildSceneGraph()
     // or: "resources/models/crate.obj"
 
     // 2) MeshRenderer in CUSTOM mode: will use MeshFilter's Model.
-    modelGO->AddComponent<MeshRenderer>(MeshRenderer::CUSTOM, WHITE);
-
-    // (Optional) if you want the model to block the player:
-    modelGO->AddComponent<BoxCollider>(
-        Vector3{ 0.7f, 2.0f, 0.7f }, 
-        Vector3{ 0, 1.0f, 0 }, 
-        true
-    );
+    modelGO->AddComponent<MeshRenderer>(MeshRenderer::CUSTOM, WHITE)->SetStaticShadowCaster(true);
 
-    sceneRoot->AddChild(modelGO);
+    // 3) MeshCollider: the player collides with the model's triangles
+    //    (uses MeshFilter's Model, so it must come after it).
+    MeshCollider* modelCollider = modelGO->AddComponent<MeshCollider>(true);
+    modelCollider->SetStatic(true);
+    UseMeshFilterGeometry(*modelCollider);
 
     // ------------------------------
     // Directional Light + Shadow Map
     // ------------------------------
-    auto sun = std::make_shared<GameObject>("Directional Light");
-    LightComponent* light = sun->AddComponent<LightComponent>(pipeline.GetLightingShader());
+    GameObject* sunGO = sceneGraph->CreateObject("Directional Light");
+    LightComponent* light = sunGO->AddComponent<LightComponent>(pipeline.GetLightingShader());
     light->SetDirection({ -0.3f, -1.0f, -0.2f });
     light->SetColor(WHITE, 1.0f);
     light->SetAmbientColor({ 0.2f, 0.2f, 0.25f });
     light->SetAmbientIntensity(1.5f);
 
     // Same here: GetShadowShader() returns Shader*
-    ShadowMap* sm = sun->AddComponent<ShadowMap>(pipeline.GetShadowShader(), 2048);
-    sceneRoot->AddChild(sun);
+    sunGO->AddComponent<ShadowMap>(pipeline.GetShadowShader(), 2048);
 
-    sunLight  = light;
-    shadowMap = sm;
+    sun = sunGO->GetHandle();
 }
 
 void DemoScene3D::Start()
 {
-    if (sceneRoot)
-        sceneRoot->Start();
+    if (sceneGraph)
+        sceneGraph->Start();
 
     // Tell the pipeline which scene + camera/light/shadow to render.
     // This is the same wiring you had in main/SceneFactory before.
-    pipeline.SetScene(sceneRoot, player, camera, sunLight, shadowMap);
+    pipeline.SetScene(sceneGraph.get(), player, player, sun);
+}
+
+void DemoScene3D::FrameUpdate(float deltaTime)
+{
+    if (!sceneGraph)
+        return;
+
+    // Frame start: collect last frame's physics results; the world is ours again.
+    physicsStage->Sync();
+    sceneGraph->FrameUpdate(deltaTime);
 }
 
 void DemoScene3D::Update(float deltaTime)
 {
-    if (!sceneRoot)
+    if (!sceneGraph)
         return;
 
-    sceneRoot->Update(deltaTime);
+    // Bring the broadphase up to date with last step's movement, then tell
+    // the components which trigger volumes were entered or left.
+    physicsWorld->SyncTransforms();
+    physicsWorld->DispatchTriggerEvents(*sceneGraph);
+    sceneGraph->Update(deltaTime);
 }
 
 void DemoScene3D::LateUpdate(float deltaTime)
 {
-    if (!sceneRoot)
+    if (!sceneGraph)
         return;
 
-    sceneRoot->LateUpdate(deltaTime);
+    sceneGraph->LateUpdate(deltaTime);
 }
 
 void DemoScene3D::Draw(RenderPipeline& pipelineRef)
@@ -163,5 +241,10 @@ void DemoScene3D::Draw(RenderPipeline& pipelineRef)
     // For now, pipelineRef is the same as `pipeline`, but we use the parameter
     // to match the Scene::Draw interface. All rendering (including shadow pass)
     // is handled inside RenderPipeline::Tick().
+
+    // Simulate this frame's submitted steps while rendering.
+    if (physicsStage)
+        physicsStage->Kick();
+
     pipelineRef.Tick();
 }
@@ -2,12 +2,12 @@
 
 #include <memory>
 
+#include "GameObjectHandle.h"
 #include "Scene.h"
 
-class GameObject;
-class CameraComponent;
-class LightComponent;
-class ShadowMap;
+class SceneGraph;
+class PhysicsWorld;
+class PhysicsStage;
 class RenderPipeline;
 
 /// A simple 3D demo scene:
@@ -19,22 +19,33 @@ class DemoScene3D : public Scene
 public:
     /// Construct the scene bound to a given RenderPipeline.
     /// The pipeline owns the shaders; the scene uses them to build objects.
-    explicit DemoScene3D(RenderPipeline& pipeline);
+    /// If scenePath names a valid scene file the objects are loaded from it,
+    /// otherwise the built-in layout is constructed in code.
+    explicit DemoScene3D(RenderPipeline& pipeline, const char* scenePath = nullptr);
+    ~DemoScene3D();
+
+    /// Write the current objects to a binary scene file (see SceneSerializer).
+    bool ExportScene(const char* path) const override;
 
     void Start() override;
+    void FrameUpdate(float deltaTime) override;
     void Update(float deltaTime) override;
     void LateUpdate(float deltaTime) override;
     void Draw(RenderPipeline& pipeline) override;
 
 private:
-    RenderPipeline&           pipeline;     // reference, not owned
-    std::shared_ptr<GameObject> sceneRoot;  // root GameObject
+    RenderPipeline&             pipeline;   // reference, not owned
+    std::unique_ptr<PhysicsWorld> physicsWorld; // declared first: outlives the colliders
+    std::unique_ptr<PhysicsStage> physicsStage; // character movement on a worker thread
+    std::unique_ptr<SceneGraph>   sceneGraph;   // owns every GameObject
 
-    GameObject*      player        = nullptr;
-    CameraComponent* camera        = nullptr;
-    LightComponent*  sunLight      = nullptr;
-    ShadowMap*       shadowMap     = nullptr;
+    // Handles, not pointers: these objects may be destroyed at runtime.
+    GameObjectHandle player;   // player + camera
+    GameObjectHandle sun;      // light + shadow map
 
     // Internal helper to build the GameObject hierarchy and cache pointers.
     void BuildSceneGraph();
+
+    // Load the hierarchy from a scene file. Returns false if it cannot be used.
+    bool LoadSceneGraph(const char* scenePath);
 };
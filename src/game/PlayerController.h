@@ -1,91 +1,71 @@
 #pragma once
 
 #include "Component.h"
+#include "CharacterMotor.h"
 #include "raylib.h"
 
 class GameObject;
+class SceneGraph;
 class BoxCollider;
 class Transform3D;
 
 // PlayerController handles first-person style movement:
 // - WASD horizontal movement
 // - Gravity and jumping
-// - Sliding against walls using axis-separated collision
-// - Ground detection using a downward raycast against BoxColliders
+// - Sliding against walls using swept (continuous) collision
+// - Ground detection using a downward raycast against the scene colliders
 // - Velocity-based ground and air control (accel/decel, reduced air control)
+//
+// The controller only turns keyboard input into a CharacterCommand per fixed
+// step; the movement itself is StepCharacter (CharacterMotor.h). With a
+// PhysicsStage in the scene it runs on the physics worker and the controller
+// applies the result one frame later; otherwise it runs inline in Update.
 class PlayerController : public Component
 {
 private:
-    // Maximum horizontal speed on ground and in air (units per second)
-    float moveSpeed = 6.0f;
-
-    // Constant downward acceleration (units per second^2, negative = down)
-    float gravity = -25.0f;
-
-    // Initial upward velocity when jumping (units per second)
-    float jumpSpeed = 10.0f;
-
-    // Full 3D velocity of the player:
-    // - X/Z = horizontal velocity
-    // - Y   = vertical velocity
-    Vector3 velocity = { 0.0f, 0.0f, 0.0f };
-
-    // Ground movement tuning
-    float groundAccel = 40.0f;   // how fast we accelerate to max speed
-    float groundDecel = 80.0f;   // how fast we slow down when no input
-
-    // Air movement tuning
-    float airAccel   = 10.0f;    // how fast we accelerate to max speed in air (lower = harder to control, range 0..groundAccel)
-    float airControl = 0.6f;     // multiplier for how strong air control is (0..1+)
-
-    // True if we consider the player to be standing on some surface
-    bool isGrounded = false;
-
-    // Root of the scene graph used to search for colliders
-    GameObject* sceneRoot = nullptr;
-
-    // === Internal helpers ===
-
-    // Recursively checks if playerCol intersects any BoxCollider in the scene
-    // (excluding the player's own GameObject). Sets hasCollision to true if hit.
-    // When ignoreFloorLikeContacts is true, collisions where the player's bottom
-    // is roughly aligned with another collider's top (standing on it) are ignored.
-    void CheckCollisionRecursive(GameObject* obj,
-                                 const BoxCollider* playerCol,
-                                 bool& hasCollision,
-                                 bool ignoreFloorLikeContacts);
-
-    // Moves the player with axis-separated collision:
-    // 1) Apply X move, resolve collision
-    // 2) Apply Z move, resolve collision
-    // 3) Apply Y move, resolve collision (floor/ceiling)
-    void MoveWithCollision(Transform3D* transform,
-                           BoxCollider* playerCol,
-                           Vector3 movement);
-
-    // Casts a downward ray from the player's feet to find the ground within maxDistance.
-    // Returns true if something was hit and writes the hit point into outGroundPoint.
-    bool RaycastGround(Vector3& outGroundPoint, float maxDistance);
-
-    // Internal recursive helper used by RaycastGround to traverse the scene graph.
-    // Tracks the closest hit against any BoxCollider in the scene.
-    void RaycastGroundRecursive(GameObject* obj,
-                                const Ray& ray,
-                                float& bestDist,
-                                Vector3& bestPoint,
-                                bool& foundHit);
+    // Speeds, gravity, accel/decel and air control (see CharacterSettings)
+    CharacterSettings settings;
+
+    // Position / velocity / grounded after the last applied step
+    CharacterState state;
+
+    // Jump pressed since the last simulation step (latched per rendered frame,
+    // so a press is neither lost nor repeated at any sim rate)
+    bool jumpRequested = false;
+
+    // Scene graph used to find the physics world / stage
+    SceneGraph* scene = nullptr;
+
+    // Body in the scene's PhysicsStage, or -1 when simulating inline
+    int body = -1;
+
+    // Builds this step's command from the keyboard (WASD relative to the
+    // transform's facing, plus the latched jump).
+    CharacterCommand ReadInput(const Transform3D* transform, float deltaTime);
+
+    // Collider box relative to the transform position (empty without a collider).
+    BoundingBox GetLocalBox(const Transform3D* transform) const;
 
 public:
-    // Constructs a controller with a given move speed and scene root.
-    PlayerController(float speed = 6.0f, GameObject* scene = nullptr);
+    // Constructs a controller with a given move speed and scene graph.
+    PlayerController(float speed = 6.0f, SceneGraph* scene = nullptr);
+
+    // Sets the scene graph used for all collision / raycast queries.
+    void SetScene(SceneGraph* scene);
 
-    // Sets the scene root used for all collision / raycast queries.
-    void SetSceneRoot(GameObject* scene);
+    // Registers a body with the scene's PhysicsStage (if it has one).
+    void Start() override;
+    void OnDestroy() override;
 
-    // Per-frame update: handles input, gravity, jumping, velocity,
-    // collision, and ground raycast.
+    // Per-rendered-frame: latches edge-triggered input (jump).
+    void FrameUpdate(float deltaTime) override;
+
+    // Fixed-step update: applies the last simulated step and submits the
+    // next command (or simulates it right away without a stage).
     void Update(float deltaTime) override;
 
+    float GetMoveSpeed() const { return settings.moveSpeed; }
+
     // Returns true if the player is currently considered grounded.
-    bool IsGrounded() const { return isGrounded; }
+    bool IsGrounded() const { return state.grounded; }
 };
@@ -0,0 +1,317 @@
+#include "SceneComponents.h"
+
+#include "SceneSerializer.h"
+#include "GameObject.h"
+#include "CameraComponent.h"
+#include "CameraController.h"
+#include "PlayerController.h"
+#include "BoxCollider.h"
+#include "MeshCollider.h"
+#include "MeshRenderer.h"
+#include "MeshFilter.h"
+#include "LightComponent.h"
+#include "ShadowMap.h"
+
+// Blob layouts. Any change here must bump SceneFile::Version.
+namespace
+{
+    using SceneFile::MakeTag;
+
+    struct CameraBlob
+    {
+        float   fov;
+        Vector3 localOffset;
+    };
+
+    struct CameraControllerBlob
+    {
+        float sensitivity;
+    };
+
+    struct PlayerControllerBlob
+    {
+        float moveSpeed;
+    };
+
+    struct BoxColliderBlob
+    {
+        Vector3  size;
+        Vector3  offset;
+        uint32_t flags;   // Collider* flags below
+        int32_t  layer;
+    };
+
+    // Shared by BoxCollider and MeshCollider.
+    const uint32_t ColliderVisible = 1u << 0;
+    const uint32_t ColliderStatic  = 1u << 1;
+    const uint32_t ColliderTrigger = 1u << 2;
+
+    struct MeshColliderBlob
+    {
+        uint32_t flags;   // Collider* flags (shape comes from the MeshFilter)
+        int32_t  layer;
+    };
+
+    struct MeshRendererBlob
+    {
+        uint32_t meshType;   // MeshRenderer::MeshType
+        Color    color;
+        uint32_t flags;      // MeshRenderer* flags below
+    };
+
+    const uint32_t MeshRendererStaticShadow = 1u << 0;
+
+    // Version 1 layouts, still read. Collider flags were a single "visible"
+    // word; later version 1 files also packed static / trigger into it and the
+    // layer into bits 8..12, and the static shadow flag into bit 31 of meshType.
+    // Files from before that leave those bits zero, so one decoder covers both.
+    struct BoxColliderBlobV1
+    {
+        Vector3  size;
+        Vector3  offset;
+        uint32_t flags;
+    };
+
+    struct MeshColliderBlobV1
+    {
+        uint32_t flags;
+    };
+
+    struct MeshRendererBlobV1
+    {
+        uint32_t meshType;
+        Color    color;
+    };
+
+    const int      V1LayerShift         = 8;
+    const uint32_t V1LayerMask          = 0x1Fu;
+    const uint32_t V1MeshRendererStatic = 1u << 31;
+
+    // BoxCollider or MeshCollider (IsVisible is not on Collider).
+    template <typename T>
+    uint32_t ColliderFlags(const T& c)
+    {
+        return (c.IsVisible() ? ColliderVisible : 0u) |
+               (c.IsStatic()  ? ColliderStatic  : 0u) |
+               (c.IsTrigger() ? ColliderTrigger : 0u);
+    }
+
+    void ApplyColliderFlags(Collider& collider, uint32_t flags, int layer)
+    {
+        collider.SetStatic((flags & ColliderStatic) != 0);
+        collider.SetTrigger((flags & ColliderTrigger) != 0);
+        collider.SetLayer(layer);
+    }
+
+    int V1Layer(uint32_t flags)
+    {
+        return static_cast<int>((flags >> V1LayerShift) & V1LayerMask);
+    }
+
+    struct MeshFilterBlob
+    {
+        uint32_t asset;   // index into the asset table
+    };
+
+    struct LightBlob
+    {
+        Vector3  direction;
+        uint32_t useTransformDirection;
+        Color    color;
+        float    intensity;
+        Vector3  ambientColor;
+        float    ambientIntensity;
+    };
+
+    struct ShadowMapBlob
+    {
+        int32_t resolution;
+    };
+
+    void DoRegister()
+    {
+        SceneSerializer::Register<CameraComponent>(MakeTag('C', 'A', 'M', 'R'),
+            [](const CameraComponent& c, SceneBlobWriter& w)
+            {
+                w.Write(CameraBlob { c.GetFOV(), c.GetLocalOffset() });
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                CameraBlob blob;
+                if (!r.Read(blob)) return;
+                CameraComponent* camera = owner.AddComponent<CameraComponent>();
+                camera->SetFOV(blob.fov);
+                camera->SetLocalOffset(blob.localOffset);
+            });
+
+        SceneSerializer::Register<CameraController>(MakeTag('C', 'A', 'M', 'C'),
+            [](const CameraController& c, SceneBlobWriter& w)
+            {
+                w.Write(CameraControllerBlob { c.GetSensitivity() });
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                CameraControllerBlob blob;
+                if (r.Read(blob))
+                    owner.AddComponent<CameraController>(blob.sensitivity);
+            });
+
+        SceneSerializer::Register<PlayerController>(MakeTag('P', 'L', 'Y', 'R'),
+            [](const PlayerController& c, SceneBlobWriter& w)
+            {
+                w.Write(PlayerControllerBlob { c.GetMoveSpeed() });
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                PlayerControllerBlob blob;
+                if (r.Read(blob))
+                    owner.AddComponent<PlayerController>(blob.moveSpeed, r.GetContext().graph);
+            });
+
+        SceneSerializer::Register<BoxCollider>(MakeTag('B', 'O', 'X', 'C'),
+            [](const BoxCollider& c, SceneBlobWriter& w)
+            {
+                w.Write(BoxColliderBlob { c.GetSize(), c.GetOffset(), ColliderFlags(c), c.GetLayer() });
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                BoxColliderBlob blob;
+                if (r.GetVersion() < 2)
+                {
+                    BoxColliderBlobV1 old;
+                    if (!r.Read(old)) return;
+                    blob = BoxColliderBlob { old.size, old.offset, old.flags, V1Layer(old.flags) };
+                }
+                else if (!r.Read(blob))
+                {
+                    return;
+                }
+
+                BoxCollider* collider = owner.AddComponent<BoxCollider>(
+                    blob.size, blob.offset, (blob.flags & ColliderVisible) != 0);
+                ApplyColliderFlags(*collider, blob.flags, blob.layer);
+            });
+
+        SceneSerializer::Register<MeshCollider>(MakeTag('M', 'C', 'O', 'L'),
+            [](const MeshCollider& c, SceneBlobWriter& w)
+            {
+                w.Write(MeshColliderBlob { ColliderFlags(c), c.GetLayer() });
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                MeshColliderBlob blob;
+                if (r.GetVersion() < 2)
+                {
+                    MeshColliderBlobV1 old;
+                    if (!r.Read(old)) return;
+                    blob = MeshColliderBlob { old.flags, V1Layer(old.flags) };
+                }
+                else if (!r.Read(blob))
+                {
+                    return;
+                }
+
+                MeshCollider* collider = owner.AddComponent<MeshCollider>((blob.flags & ColliderVisible) != 0);
+                UseMeshFilterGeometry(*collider);
+                ApplyColliderFlags(*collider, blob.flags, blob.layer);
+            });
+
+        SceneSerializer::Register<MeshRenderer>(MakeTag('M', 'R', 'N', 'D'),
+            [](const MeshRenderer& c, SceneBlobWriter& w)
+            {
+                const uint32_t flags = c.IsStaticShadowCaster() ? MeshRendererStaticShadow : 0u;
+                w.Write(MeshRendererBlob { static_cast<uint32_t>(c.GetMeshType()), c.GetColor(), flags });
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                MeshRendererBlob blob;
+                if (r.GetVersion() < 2)
+                {
+                    MeshRendererBlobV1 old;
+                    if (!r.Read(old)) return;
+                    blob = MeshRendererBlob { old.meshType & ~V1MeshRendererStatic, old.color,
+                                              (old.meshType & V1MeshRendererStatic) ? MeshRendererStaticShadow : 0u };
+                }
+                else if (!r.Read(blob))
+                {
+                    return;
+                }
+
+                if (blob.meshType > MeshRenderer::CUSTOM) return;
+                MeshRenderer* renderer = owner.AddComponent<MeshRenderer>(static_cast<MeshRenderer::MeshType>(blob.meshType), blob.color);
+                renderer->SetStaticShadowCaster((blob.flags & MeshRendererStaticShadow) != 0);
+            });
+
+        SceneSerializer::Register<MeshFilter>(MakeTag('M', 'F', 'L', 'T'),
+            [](const MeshFilter& c, SceneBlobWriter& w)
+            {
+                // Models assigned in code have no path; they come back as an empty filter.
+                const uint32_t noAsset = 0xFFFFFFFFu;
+                w.Write(MeshFilterBlob { c.GetModelPath().empty() ? noAsset : w.AddAsset(c.GetModelPath()) });
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                MeshFilterBlob blob;
+                if (!r.Read(blob)) return;
+                const char* path = r.GetAsset(blob.asset);
+                if (path)
+                    owner.AddComponent<MeshFilter>(path);
+                else
+                    owner.AddComponent<MeshFilter>();
+            });
+
+        SceneSerializer::Register<LightComponent>(MakeTag('L', 'I', 'G', 'T'),
+            [](const LightComponent& c, SceneBlobWriter& w)
+            {
+                LightBlob blob;
+                blob.direction             = c.GetDirection();
+                blob.useTransformDirection = c.UsesTransformDirection() ? 1u : 0u;
+                blob.color                 = c.GetColor();
+                blob.intensity             = c.GetIntensity();
+                blob.ambientColor          = c.GetAmbientColor();
+                blob.ambientIntensity      = c.GetAmbientIntensity();
+                w.Write(blob);
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                LightBlob blob;
+                if (!r.Read(blob)) return;
+                LightComponent* light = owner.AddComponent<LightComponent>(r.GetContext().lightingShader);
+                light->SetDirection(blob.direction);
+                light->SetUseTransformDirection(blob.useTransformDirection != 0);
+                light->SetColor(blob.color, blob.intensity);
+                light->SetAmbientColor(blob.ambientColor);
+                light->SetAmbientIntensity(blob.ambientIntensity);
+            });
+
+        SceneSerializer::Register<ShadowMap>(MakeTag('S', 'H', 'D', 'W'),
+            [](const ShadowMap& c, SceneBlobWriter& w)
+            {
+                w.Write(ShadowMapBlob { c.GetResolution() });
+            },
+            [](GameObject& owner, SceneBlobReader& r)
+            {
+                ShadowMapBlob blob;
+                if (r.Read(blob) && blob.resolution > 0)
+                    owner.AddComponent<ShadowMap>(r.GetContext().shadowShader, blob.resolution);
+            });
+    }
+}
+
+void RegisterSceneComponents()
+{
+    static const bool registered = (DoRegister(), true);
+    (void)registered;
+}
+
+void UseMeshFilterGeometry(MeshCollider& collider)
+{
+    GameObject*       owner  = collider.GetGameObject();
+    const MeshFilter* filter = owner->GetComponent<MeshFilter>();
+
+    collider.SetModelSource([owner]() -> const Model*
+    {
+        MeshFilter* current = owner->GetComponent<MeshFilter>();
+        return current && current->HasModel() ? &current->GetModel() : nullptr;
+    }, filter ? filter->GetModelPath() : std::string());
+}
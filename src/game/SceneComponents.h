@@ -0,0 +1,12 @@
+#pragma once
+
+// Registers the built-in components with SceneSerializer (tags + blob layouts).
+// Safe to call more than once and from any thread; only the first call registers.
+void RegisterSceneComponents();
+
+class MeshCollider;
+
+// Points a MeshCollider at the MeshFilter model of its object (looked up when
+// the collider starts). Add the collider after the filter so the model path
+// keys the shared triangle tree.
+void UseMeshFilterGeometry(MeshCollider& collider);
@@ -0,0 +1,361 @@
+#include "AabbTree.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+
+AabbTree::AabbTree(float fatMargin)
+    : margin(fatMargin)
+{
+}
+
+// ---------------------------------------------------------------------
+// Box helpers
+// ---------------------------------------------------------------------
+
+bool AabbTree::Overlaps(const BoundingBox& a, const BoundingBox& b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+           a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+bool AabbTree::Contains(const BoundingBox& outer, const BoundingBox& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+           outer.max.x >= inner.max.x && outer.max.y >= inner.max.y && outer.max.z >= inner.max.z;
+}
+
+BoundingBox AabbTree::Union(const BoundingBox& a, const BoundingBox& b)
+{
+    return {
+        { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) },
+        { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) }
+    };
+}
+
+float AabbTree::SurfaceArea(const BoundingBox& box)
+{
+    const float dx = box.max.x - box.min.x;
+    const float dy = box.max.y - box.min.y;
+    const float dz = box.max.z - box.min.z;
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+bool AabbTree::RayEntersBox(Vector3 origin, Vector3 invDir, const BoundingBox& box,
+                            float maxDistance, float& outDistance)
+{
+    float tMin = 0.0f;
+    float tMax = maxDistance;
+
+    const float o[3]   = { origin.x, origin.y, origin.z };
+    const float inv[3] = { invDir.x, invDir.y, invDir.z };
+    const float lo[3]  = { box.min.x, box.min.y, box.min.z };
+    const float hi[3]  = { box.max.x, box.max.y, box.max.z };
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::isinf(inv[axis]))
+        {
+            // Parallel to this slab: inside it or never.
+            if (o[axis] < lo[axis] || o[axis] > hi[axis])
+                return false;
+            continue;
+        }
+
+        float t1 = (lo[axis] - o[axis]) * inv[axis];
+        float t2 = (hi[axis] - o[axis]) * inv[axis];
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax)
+            return false;
+    }
+
+    outDistance = tMin;
+    return true;
+}
+
+// ---------------------------------------------------------------------
+// Node pool
+// ---------------------------------------------------------------------
+
+int AabbTree::AllocateNode()
+{
+    if (freeList == Null)
+    {
+        nodes.emplace_back();
+        freeList = static_cast<int>(nodes.size()) - 1;
+        nodes[freeList].parent = Null;
+    }
+
+    const int index = freeList;
+    freeList = nodes[index].parent;
+
+    Node& node    = nodes[index];
+    node.userData = nullptr;
+    node.layers   = AllLayers;
+    node.parent   = Null;
+    node.child1   = Null;
+    node.child2   = Null;
+    node.height   = 0;
+    return index;
+}
+
+void AabbTree::FreeNode(int index)
+{
+    nodes[index].parent = freeList;
+    nodes[index].height = -1;
+    freeList = index;
+}
+
+// ---------------------------------------------------------------------
+// Proxies
+// ---------------------------------------------------------------------
+
+int AabbTree::CreateProxy(const BoundingBox& box, void* userData, uint32_t layers)
+{
+    const int proxy = AllocateNode();
+
+    const Vector3 grow = { margin, margin, margin };
+    nodes[proxy].box      = { Vector3Subtract(box.min, grow), Vector3Add(box.max, grow) };
+    nodes[proxy].userData = userData;
+    nodes[proxy].layers   = layers;
+    nodes[proxy].height   = 0;
+
+    InsertLeaf(proxy);
+    ++proxyCount;
+    return proxy;
+}
+
+void AabbTree::DestroyProxy(int proxy)
+{
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --proxyCount;
+}
+
+void AabbTree::SetProxyLayers(int proxy, uint32_t layers)
+{
+    nodes[proxy].layers = layers;
+
+    // Only the layer unions change: no rebalancing needed.
+    for (int index = nodes[proxy].parent; index != Null; index = nodes[index].parent)
+        nodes[index].layers = nodes[nodes[index].child1].layers | nodes[nodes[index].child2].layers;
+}
+
+bool AabbTree::MoveProxy(int proxy, const BoundingBox& box, Vector3 displacement)
+{
+    // Still inside the fat box: nothing to do.
+    if (Contains(nodes[proxy].box, box))
+        return false;
+
+    RemoveLeaf(proxy);
+
+    // Grow by the margin, then stretch along the motion so the next few moves fit.
+    const float predict = 2.0f;
+    BoundingBox fat = {
+        { box.min.x - margin, box.min.y - margin, box.min.z - margin },
+        { box.max.x + margin, box.max.y + margin, box.max.z + margin }
+    };
+
+    const Vector3 d = Vector3Scale(displacement, predict);
+    if (d.x < 0.0f) fat.min.x += d.x; else fat.max.x += d.x;
+    if (d.y < 0.0f) fat.min.y += d.y; else fat.max.y += d.y;
+    if (d.z < 0.0f) fat.min.z += d.z; else fat.max.z += d.z;
+
+    nodes[proxy].box = fat;
+    InsertLeaf(proxy);
+    return true;
+}
+
+// ---------------------------------------------------------------------
+// Tree maintenance
+// ---------------------------------------------------------------------
+
+void AabbTree::InsertLeaf(int leaf)
+{
+    if (root == Null)
+    {
+        root = leaf;
+        nodes[root].parent = Null;
+        return;
+    }
+
+    // 1) Walk down to the cheapest sibling (surface area heuristic).
+    const BoundingBox leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].IsLeaf())
+    {
+        const Node& node = nodes[index];
+        const float area = SurfaceArea(node.box);
+
+        // Cost of making a new parent for this node and the leaf.
+        const float combinedArea = SurfaceArea(Union(node.box, leafBox));
+        const float cost         = 2.0f * combinedArea;
+
+        // Minimum cost of pushing the leaf further down.
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int child)
+        {
+            const BoundingBox merged = Union(leafBox, nodes[child].box);
+            if (nodes[child].IsLeaf())
+                return SurfaceArea(merged) + inheritanceCost;
+            return SurfaceArea(merged) - SurfaceArea(nodes[child].box) + inheritanceCost;
+        };
+
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int sibling = index;
+
+    // 2) Create a new parent for the sibling and the leaf.
+    const int oldParent = nodes[sibling].parent;
+    const int newParent = AllocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box    = Union(leafBox, nodes[sibling].box);
+    nodes[newParent].layers = nodes[leaf].layers | nodes[sibling].layers;
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent   = newParent;
+    nodes[leaf].parent      = newParent;
+
+    if (oldParent != Null)
+    {
+        if (nodes[oldParent].child1 == sibling)
+            nodes[oldParent].child1 = newParent;
+        else
+            nodes[oldParent].child2 = newParent;
+    }
+    else
+    {
+        root = newParent;
+    }
+
+    // 3) Walk back up, rebalancing and refitting.
+    Refit(nodes[leaf].parent);
+}
+
+void AabbTree::RemoveLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = Null;
+        return;
+    }
+
+    const int parent      = nodes[leaf].parent;
+    const int grandParent = nodes[parent].parent;
+    const int sibling     = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent != Null)
+    {
+        // Replace the parent by the sibling.
+        if (nodes[grandParent].child1 == parent)
+            nodes[grandParent].child1 = sibling;
+        else
+            nodes[grandParent].child2 = sibling;
+        nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        Refit(grandParent);
+    }
+    else
+    {
+        root = sibling;
+        nodes[sibling].parent = Null;
+        FreeNode(parent);
+    }
+
+    nodes[leaf].parent = Null;
+}
+
+void AabbTree::Refit(int index)
+{
+    while (index != Null)
+    {
+        index = Balance(index);
+
+        Node& node = nodes[index];
+        node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+        node.box    = Union(nodes[node.child1].box, nodes[node.child2].box);
+        node.layers = nodes[node.child1].layers | nodes[node.child2].layers;
+
+        index = node.parent;
+    }
+}
+
+// Rotate the taller grandchild up if the subtree at A is imbalanced.
+// Returns the index of the node now at A's position.
+int AabbTree::Balance(int iA)
+{
+    Node& A = nodes[iA];
+    if (A.IsLeaf() || A.height < 2)
+        return iA;
+
+    const int iB = A.child1;
+    const int iC = A.child2;
+    const int balance = nodes[iC].height - nodes[iB].height;
+
+    // Rotate C up (C is taller) or B up (B is taller); the two cases are mirrored.
+    auto rotateUp = [this, iA](int iUp, int iOther, bool upWasChild2) -> int
+    {
+        Node& a  = nodes[iA];
+        Node& up = nodes[iUp];
+        const int iF = up.child1;
+        const int iG = up.child2;
+
+        // Swap A and Up.
+        up.child1 = iA;
+        up.parent = a.parent;
+        a.parent  = iUp;
+
+        if (up.parent != Null)
+        {
+            if (nodes[up.parent].child1 == iA)
+                nodes[up.parent].child1 = iUp;
+            else
+                nodes[up.parent].child2 = iUp;
+        }
+        else
+        {
+            root = iUp;
+        }
+
+        // Keep the taller of Up's children under Up, give the other to A.
+        const bool fTaller = nodes[iF].height > nodes[iG].height;
+        const int  iKeep   = fTaller ? iF : iG;
+        const int  iGive   = fTaller ? iG : iF;
+
+        up.child2 = iKeep;
+        if (upWasChild2)
+            a.child2 = iGive;
+        else
+            a.child1 = iGive;
+        nodes[iGive].parent = iA;
+
+        a.box     = Union(nodes[iOther].box, nodes[iGive].box);
+        up.box    = Union(a.box, nodes[iKeep].box);
+        a.layers  = nodes[iOther].layers | nodes[iGive].layers;
+        up.layers = a.layers | nodes[iKeep].layers;
+        a.height  = 1 + std::max(nodes[iOther].height, nodes[iGive].height);
+        up.height = 1 + std::max(a.height, nodes[iKeep].height);
+        return iUp;
+    };
+
+    if (balance > 1)
+        return rotateUp(iC, iB, true);
+    if (balance < -1)
+        return rotateUp(iB, iC, false);
+    return iA;
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+#include "RayPacket.h"
+
+// AabbTree:
+// - Dynamic bounding volume hierarchy over axis-aligned boxes (broadphase).
+// - Leaves store a "fat" box (the real box grown by a margin and stretched in
+//   the direction of motion), so small moves do not touch the tree at all.
+// - Insertion picks the sibling with the lowest surface-area cost and the tree
+//   is kept balanced with AVL-style rotations, so queries stay O(log N).
+// - Proxies are integer ids, stable until DestroyProxy().
+// - Each proxy carries layer bits; every node keeps the union of its subtree's
+//   layers, so queries with a layer mask skip whole subtrees before any box test.
+class AabbTree
+{
+public:
+    static constexpr int      Null      = -1;
+    static constexpr uint32_t AllLayers = 0xFFFFFFFFu;
+
+    explicit AabbTree(float fatMargin = 0.1f);
+
+    // Insert a box. userData is returned by GetUserData() / handed to queries.
+    int  CreateProxy(const BoundingBox& box, void* userData, uint32_t layers = AllLayers);
+    void DestroyProxy(int proxy);
+
+    // Change a proxy's layer bits (refits the layer unions up to the root).
+    void     SetProxyLayers(int proxy, uint32_t layers);
+    uint32_t GetProxyLayers(int proxy) const { return nodes[proxy].layers; }
+
+    // Update a proxy after its box changed. displacement is the movement since the
+    // last update (used to predict the fat box). Returns true if the leaf had to
+    // be re-inserted, false if the new box still fits inside the old fat box.
+    bool MoveProxy(int proxy, const BoundingBox& box, Vector3 displacement);
+
+    void*              GetUserData(int proxy) const { return nodes[proxy].userData; }
+    const BoundingBox& GetFatBox(int proxy) const   { return nodes[proxy].box; }
+
+    int GetProxyCount() const { return proxyCount; }
+    int GetHeight() const { return root == Null ? 0 : nodes[root].height; }
+
+    // Calls fn(proxy) for every leaf whose fat box overlaps box and whose
+    // layers intersect layerMask. fn returns false to stop the query early.
+    template <typename Fn>
+    void Query(const BoundingBox& box, Fn&& fn, uint32_t layerMask = AllLayers) const;
+
+    // Calls fn(proxy, maxDistance) for every leaf in layerMask whose fat box the
+    // ray enters within maxDistance. ray.direction must be normalized. fn returns
+    // the new maxDistance (e.g. the distance of an exact hit, to clip the rest
+    // of the search), or a negative value to stop.
+    template <typename Fn>
+    void Raycast(const Ray& ray, float maxDistance, Fn&& fn, uint32_t layerMask = AllLayers) const;
+
+    // Raycast for up to 4 rays in one walk (see RayPacket): each node is
+    // tested against every lane at once. Calls fn(lane, proxy, maxDistance)
+    // for every leaf in the lane's layer mask whose fat box that lane's ray
+    // enters; fn returns the lane's new maxDistance (negative: the lane is done).
+    template <typename Fn>
+    void RaycastPacket(RayPacket& packet, Fn&& fn) const;
+
+private:
+    struct Node
+    {
+        BoundingBox box {};
+        void*       userData = nullptr;
+        uint32_t    layers   = AllLayers;   // leaf: its own; inner: union of the children
+        int         parent   = Null;   // next free node while on the free list
+        int         child1   = Null;
+        int         child2   = Null;
+        int         height   = -1;     // 0 for leaves, -1 for free nodes
+
+        bool IsLeaf() const { return child1 == Null; }
+    };
+
+    std::vector<Node> nodes;
+    int   root       = Null;
+    int   freeList   = Null;
+    int   proxyCount = 0;
+    float margin;
+
+    int  AllocateNode();
+    void FreeNode(int node);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int  Balance(int node);
+    void Refit(int node);
+
+    // Scratch stack used by the traversal templates (inline storage, spills to the heap).
+    class NodeStack
+    {
+    public:
+        void Push(int node)
+        {
+            if (count < InlineCapacity) { inlineNodes[count++] = node; return; }
+            overflow.push_back(node);
+            ++count;
+        }
+
+        int Pop()
+        {
+            --count;
+            if (count < InlineCapacity)
+                return inlineNodes[count];
+            const int node = overflow.back();
+            overflow.pop_back();
+            return node;
+        }
+
+        bool Empty() const { return count == 0; }
+
+    private:
+        static constexpr int InlineCapacity = 64;
+        int              inlineNodes[InlineCapacity];
+        int              count = 0;
+        std::vector<int> overflow;
+    };
+
+public:
+    // Box helpers shared with the narrow phase.
+    static bool  Overlaps(const BoundingBox& a, const BoundingBox& b);
+    static bool  Contains(const BoundingBox& outer, const BoundingBox& inner);
+    static BoundingBox Union(const BoundingBox& a, const BoundingBox& b);
+    static float SurfaceArea(const BoundingBox& box);
+
+    // Slab test. invDir = 1 / ray direction (per axis). On a hit within
+    // [0, maxDistance] writes the entry distance (0 if the origin is inside).
+    static bool RayEntersBox(Vector3 origin, Vector3 invDir, const BoundingBox& box,
+                             float maxDistance, float& outDistance);
+};
+
+template <typename Fn>
+void AabbTree::Query(const BoundingBox& box, Fn&& fn, uint32_t layerMask) const
+{
+    if (root == Null)
+        return;
+
+    NodeStack stack;
+    stack.Push(root);
+
+    while (!stack.Empty())
+    {
+        const int   index = stack.Pop();
+        const Node& node  = nodes[index];
+        if (!(node.layers & layerMask) || !Overlaps(node.box, box))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (!fn(index))
+                return;
+        }
+        else
+        {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
+
+template <typename Fn>
+void AabbTree::Raycast(const Ray& ray, float maxDistance, Fn&& fn, uint32_t layerMask) const
+{
+    if (root == Null)
+        return;
+
+    const Vector3 invDir = {
+        1.0f / ray.direction.x,   // +-inf for axis-parallel rays, handled by the slab test
+        1.0f / ray.direction.y,
+        1.0f / ray.direction.z
+    };
+
+    NodeStack stack;
+    stack.Push(root);
+
+    while (!stack.Empty())
+    {
+        const int   index = stack.Pop();
+        const Node& node  = nodes[index];
+        if (!(node.layers & layerMask))
+            continue;
+
+        float entry;
+        if (!RayEntersBox(ray.position, invDir, node.box, maxDistance, entry))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            maxDistance = fn(index, maxDistance);
+            if (maxDistance < 0.0f)
+                return;
+        }
+        else
+        {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
+
+template <typename Fn>
+void AabbTree::RaycastPacket(RayPacket& packet, Fn&& fn) const
+{
+    if (root == Null)
+        return;
+
+    NodeStack stack;
+    stack.Push(root);
+
+    float entry[RayPacket::Lanes];
+    while (!stack.Empty())
+    {
+        const int   index = stack.Pop();
+        const Node& node  = nodes[index];
+        int lanes = packet.LayerLanes(node.layers);
+        if (!lanes || !(lanes &= packet.Enters(node.box, entry)))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            for (int lane = 0; lane < RayPacket::Lanes; ++lane)
+            {
+                if (lanes & (1 << lane))
+                    packet.maxDistance[lane] = fn(lane, index, packet.maxDistance[lane]);
+            }
+            if (!packet.ActiveLanes())
+                return;
+        }
+        else
+        {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
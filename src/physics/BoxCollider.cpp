@@ -3,18 +3,17 @@
 #include "Transform3D.h"
 #include "raymath.h"
 
-BoxCollider::BoxCollider(Vector3 size, Vector3 offset, bool visible) 
+BoxCollider::BoxCollider(Vector3 size, Vector3 offset, bool visible)
     : size(size), offset(offset), visible(visible) {}
 
 Vector3 BoxCollider::GetSize() const { return size; }
-void BoxCollider::SetSize(Vector3 s) { size = s; }
+void BoxCollider::SetSize(Vector3 s) { size = s; OnShapeChanged(); }
 
 Vector3 BoxCollider::GetOffset() const { return offset; }
-void BoxCollider::SetOffset(Vector3 o) { offset = o; }
+void BoxCollider::SetOffset(Vector3 o) { offset = o; OnShapeChanged(); }
 
-BoundingBox BoxCollider::GetBounds() const {
-    Transform3D* transform = gameObject->GetTransform();
-    Vector3 pos = Vector3Add(transform->GetPosition(), offset);
+BoundingBox BoxCollider::ComputeBounds() const {
+    Vector3 pos = Vector3Add(gameObject->GetTransform()->GetWorldPosition(), offset);
     Vector3 halfSize = Vector3Scale(size, 0.5f);
     return {
         Vector3Subtract(pos, halfSize),
@@ -22,7 +21,7 @@ BoundingBox BoxCollider::GetBounds() const {
     };
 }
 
-bool BoxCollider::CheckCollision(const BoxCollider* other) const {
+bool BoxCollider::CheckCollision(const Collider* other) const {
     return CheckCollisionBoxes(GetBounds(), other->GetBounds());
 }
 
@@ -30,4 +29,4 @@ void BoxCollider::Draw() {
     if (!visible) return;
     BoundingBox bounds = GetBounds();
     DrawBoundingBox(bounds, GREEN);
-}
\ No newline at end of file
+}
@@ -1,25 +1,29 @@
 #pragma once
 
 #include "raylib.h"
-#include "Component.h"
+#include "Collider.h"
 
-class BoxCollider : public Component {
+class BoxCollider : public Collider {
 private:
     Vector3 size = {1, 1, 1};
     Vector3 offset = {0, 0, 0};
     bool visible = true;
-    
+
+protected:
+    BoundingBox ComputeBounds() const override;
+
 public:
     BoxCollider(Vector3 size = {1, 1, 1}, Vector3 offset = {0, 0, 0}, bool visible = true);
-    
+
     Vector3 GetSize() const;
     void SetSize(Vector3 s);
-    
+
     Vector3 GetOffset() const;
     void SetOffset(Vector3 o);
-    
-    BoundingBox GetBounds() const;
-    bool CheckCollision(const BoxCollider* other) const;
-    
+
+    bool IsVisible() const { return visible; }
+
+    bool CheckCollision(const Collider* other) const;
+
     void Draw() override;
-};
\ No newline at end of file
+};
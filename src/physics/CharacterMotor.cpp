@@ -0,0 +1,402 @@
+#include "CharacterMotor.h"
+#include "PhysicsWorld.h"
+#include "JobSystem.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const float kMaxProbeDistance = 0.15f;  // how far below the feet the ground probe looks
+
+    // Agents per CharacterMotorSystem batch (one job, one RaycastBatch).
+    const int kAgentBatchSize = 64;
+
+    // Layers a character's own collider meets (all of them without a collider).
+    uint32_t QueryMask(const PhysicsWorld& world, const Collider* self)
+    {
+        return self ? world.GetLayerMask(self->GetLayer()) : PhysicsWorld::AllLayers;
+    }
+
+    BoundingBox Offset(const BoundingBox& box, Vector3 position)
+    {
+        return { Vector3Add(box.min, position), Vector3Add(box.max, position) };
+    }
+
+    // Jump, gravity and horizontal acceleration / deceleration (ground vs air),
+    // clamped to moveSpeed. Returns the new velocity.
+    Vector3 UpdateVelocity(const CharacterSettings& settings, Vector3 inputDir, bool jump, float dt,
+                           Vector3 velocity, bool& grounded)
+    {
+        // Jump + gravity (vertical velocity only)
+        if (grounded && jump)
+        {
+            velocity.y = settings.jumpSpeed;
+            grounded   = false;
+        }
+        velocity.y += settings.gravity * dt;
+
+        Vector3 horizVel = { velocity.x, 0.0f, velocity.z };
+        const bool hasInput = Vector3Length(inputDir) > 0.0f;
+
+        if (hasInput)
+        {
+            // Accelerate toward moveSpeed in the input direction: current speed
+            // along it, and how much more we may add
+            const float currentSpeedAlong = Vector3DotProduct(horizVel, inputDir);
+            const float addSpeed = settings.moveSpeed - currentSpeedAlong;
+
+            if (addSpeed > 0.0f)
+            {
+                // Choose acceleration based on grounded vs air
+                const float accel = grounded ? settings.groundAccel : (settings.airAccel * settings.airControl);
+
+                float accelSpeed = accel * dt;
+                if (accelSpeed > addSpeed)
+                    accelSpeed = addSpeed;
+
+                horizVel = Vector3Add(horizVel, Vector3Scale(inputDir, accelSpeed));
+            }
+        }
+        else if (grounded)
+        {
+            // No input: apply ground friction so we don't stop instantly.
+            float speed = Vector3Length(horizVel);
+            if (speed > 0.0f)
+            {
+                speed -= settings.groundDecel * dt;
+                horizVel = speed > 0.0f ? Vector3Scale(Vector3Normalize(horizVel), speed)
+                                        : Vector3{ 0.0f, 0.0f, 0.0f };
+            }
+        }
+        // In air with no input: leave horizVel as-is (inertia).
+
+        // Clamp horizontal speed to max
+        const float horizSpeed = Vector3Length(horizVel);
+        if (horizSpeed > settings.moveSpeed && horizSpeed > 0.0f)
+            horizVel = Vector3Scale(Vector3Normalize(horizVel), settings.moveSpeed);
+
+        return { horizVel.x, velocity.y, horizVel.z };
+    }
+
+    // Swept movement: cast the box along the move, stop at the first contact
+    // and slide the rest of the move along the contact surface.
+    void MoveWithCollision(const PhysicsWorld& world, const Collider* self, const BoundingBox& localBox,
+                           Vector3 movement, CharacterState& state)
+    {
+        // Each iteration resolves one contact; floor + wall + a corner need three.
+        const int   maxIterations = 4;
+        const float skinWidth     = 0.001f;  // stop this short of a contact
+        const float stepHeight    = 0.05f;   // ledges up to this high are walked onto
+
+        Vector3 remaining = movement;
+        const uint32_t mask = QueryMask(world, self);
+
+        for (int i = 0; i < maxIterations; ++i)
+        {
+            const float length = Vector3Length(remaining);
+            if (length < 1e-6f)
+                break;
+
+            const BoundingBox box = Offset(localBox, state.position);
+            SweepHit hit;
+            if (!world.SweepBox(box, remaining, hit, self, mask))
+            {
+                // Free movement for the rest of the move
+                state.position = Vector3Add(state.position, remaining);
+                break;
+            }
+
+            // Floor-like contact: a side hit on something whose top is at (or
+            // barely above) our feet. Step onto it instead of stopping, so seams
+            // and tiny ledges don't lock horizontal movement. The top is the
+            // part that was hit (a mesh's triangle, not the whole mesh).
+            const float otherTop = hit.contactTop;
+            if (hit.normal.y == 0.0f && otherTop > box.min.y && otherTop <= box.min.y + stepHeight)
+            {
+                state.position.y += otherTop - box.min.y + skinWidth;
+                continue;
+            }
+
+            // Advance up to the contact, minus a small skin so the next cast
+            // does not start out touching it.
+            const float travel = fmaxf(hit.time - skinWidth / length, 0.0f);
+            state.position = Vector3Add(state.position, Vector3Scale(remaining, travel));
+
+            // Slide: drop the part of the leftover move (and of the velocity) that
+            // goes into the surface. A floor or ceiling hit zeroes vertical speed;
+            // grounded is still decided by the ground raycast.
+            remaining = Vector3Scale(remaining, 1.0f - travel);
+
+            const float into = Vector3DotProduct(remaining, hit.normal);
+            if (into < 0.0f)
+                remaining = Vector3Subtract(remaining, Vector3Scale(hit.normal, into));
+
+            const float velInto = Vector3DotProduct(state.velocity, hit.normal);
+            if (velInto < 0.0f)
+                state.velocity = Vector3Subtract(state.velocity, Vector3Scale(hit.normal, velInto));
+        }
+    }
+
+    // Ground probe ray: straight down from the feet, slightly above the bottom
+    // to avoid self-hitting. Only cast while not moving up.
+    Ray GroundProbeRay(const BoundingBox& localBox, Vector3 position)
+    {
+        const BoundingBox box = Offset(localBox, position);
+        Ray ray;
+        ray.position  = { (box.min.x + box.max.x) * 0.5f, box.min.y + 0.01f, (box.min.z + box.max.z) * 0.5f };
+        ray.direction = { 0.0f, -1.0f, 0.0f };
+        return ray;
+    }
+
+    // Ground probe result (hit is null if the probe found nothing): decide if
+    // we are on/near the ground and fix small downward penetration by snapping
+    // UP out of the floor. It never pulls the character down; landing height
+    // is decided by MoveWithCollision.
+    void ResolveGround(const RaycastHit* hit, const BoundingBox& localBox, CharacterState& state)
+    {
+        state.grounded = false;
+        if (!hit)
+            return;
+
+        const float groundEps      = 0.08f; // how far from target we still consider "on ground"
+        const float maxPenetration = 0.20f; // max we will snap UP to fix penetration
+
+        const BoundingBox box = Offset(localBox, state.position);
+
+        // Positive diff: we're slightly INSIDE the ground
+        // Negative diff: we're slightly ABOVE the ground
+        const float halfHeight = (box.max.y - box.min.y) * 0.5f;
+        const float targetY    = hit->point.y + halfHeight - ((box.min.y + box.max.y) * 0.5f - state.position.y);
+        const float diff       = targetY - state.position.y;
+
+        if (fabsf(diff) <= groundEps)
+        {
+            // Basically at the right height: grounded, no Y adjustment.
+            state.velocity.y = 0.0f;
+            state.grounded   = true;
+        }
+        else if (diff > 0.0f && diff <= maxPenetration)
+        {
+            // Sank slightly into the ground: snap UP to the surface.
+            state.position.y = targetY;
+            state.velocity.y = 0.0f;
+            state.grounded   = true;
+        }
+        // Else: too far above or deeply inside something; airborne.
+    }
+}
+
+void StepCharacter(const PhysicsWorld* world, const Collider* self, const BoundingBox& localBox,
+                   const CharacterSettings& settings, const CharacterCommand& command,
+                   CharacterState& state)
+{
+    const float dt = command.deltaTime;
+
+    state.velocity = UpdateVelocity(settings, command.moveDirection, command.jump, dt,
+                                    state.velocity, state.grounded);
+
+    // Velocity -> movement delta, resolved against the world
+    const Vector3 movement = Vector3Scale(state.velocity, dt);
+    if (!world)
+    {
+        state.position = Vector3Add(state.position, movement);
+        state.grounded = false;
+        return;
+    }
+
+    MoveWithCollision(*world, self, localBox, movement, state);
+
+    RaycastHit hit;
+    const bool probe = state.velocity.y <= 0.0f &&
+                       world->Raycast(GroundProbeRay(localBox, state.position), kMaxProbeDistance, hit, self,
+                                      QueryMask(*world, self));
+    ResolveGround(probe ? &hit : nullptr, localBox, state);
+}
+
+// ---------------------------------------------------------------------
+// CharacterMotorSystem
+// ---------------------------------------------------------------------
+
+CharacterMotorSystem::CharacterMotorSystem(const CharacterSettings& motorSettings)
+    : settings(motorSettings)
+{
+}
+
+int CharacterMotorSystem::AddAgent(Vector3 position, const BoundingBox& localBox, const Collider* collider)
+{
+    const int slot = static_cast<int>(positions.size());
+
+    int agent;
+    if (!freeAgents.empty())
+    {
+        agent = freeAgents.back();
+        freeAgents.pop_back();
+        agentSlots[agent] = slot;
+    }
+    else
+    {
+        agent = static_cast<int>(agentSlots.size());
+        agentSlots.push_back(slot);
+    }
+
+    positions.push_back(position);
+    velocities.push_back({ 0.0f, 0.0f, 0.0f });
+    moveDirections.push_back({ 0.0f, 0.0f, 0.0f });
+    jumps.push_back(0);
+    grounded.push_back(0);
+    localBoxes.push_back(localBox);
+    colliders.push_back(collider);
+    slotAgents.push_back(agent);
+    return agent;
+}
+
+void CharacterMotorSystem::RemoveAgent(int agent)
+{
+    if (agent < 0 || agent >= static_cast<int>(agentSlots.size()) || agentSlots[agent] == Null)
+        return;
+
+    // Swap-remove: the last slot moves into the freed one.
+    const std::size_t slot = agentSlots[agent];
+    const std::size_t last = positions.size() - 1;
+
+    positions[slot]      = positions[last];
+    velocities[slot]     = velocities[last];
+    moveDirections[slot] = moveDirections[last];
+    jumps[slot]          = jumps[last];
+    grounded[slot]       = grounded[last];
+    localBoxes[slot]     = localBoxes[last];
+    colliders[slot]      = colliders[last];
+    slotAgents[slot]     = slotAgents[last];
+    agentSlots[slotAgents[slot]] = static_cast<int>(slot);
+
+    positions.pop_back();
+    velocities.pop_back();
+    moveDirections.pop_back();
+    jumps.pop_back();
+    grounded.pop_back();
+    localBoxes.pop_back();
+    colliders.pop_back();
+    slotAgents.pop_back();
+
+    agentSlots[agent] = Null;
+    freeAgents.push_back(agent);
+}
+
+void CharacterMotorSystem::SetCommand(int agent, Vector3 moveDirection, bool jump)
+{
+    const int slot = agentSlots[agent];
+    moveDirections[slot] = moveDirection;
+    jumps[slot]          = jump ? 1 : 0;
+}
+
+CharacterState CharacterMotorSystem::GetState(int agent) const
+{
+    const int slot = agentSlots[agent];
+
+    CharacterState state;
+    state.position = positions[slot];
+    state.velocity = velocities[slot];
+    state.grounded = grounded[slot] != 0;
+    return state;
+}
+
+void CharacterMotorSystem::SetPosition(int agent, Vector3 position)
+{
+    positions[agentSlots[agent]] = position;
+}
+
+void CharacterMotorSystem::Step(const PhysicsWorld* world, float deltaTime)
+{
+    const std::size_t count = positions.size();
+    if (count == 0)
+        return;
+
+    JobSystem* jobs = JobSystem::Get();
+    if (!jobs || count <= static_cast<std::size_t>(kAgentBatchSize))
+    {
+        for (std::size_t begin = 0; begin < count; begin += kAgentBatchSize)
+            StepBatch(world, deltaTime, begin, std::min(begin + kAgentBatchSize, count));
+        return;
+    }
+
+    // Batches only touch their own slots and read the world.
+    jobs->Wait(jobs->ParallelFor(count, kAgentBatchSize,
+        [this, world, deltaTime](std::size_t begin, std::size_t end)
+        {
+            StepBatch(world, deltaTime, begin, end);
+        }));
+}
+
+void CharacterMotorSystem::StepBatch(const PhysicsWorld* world, float deltaTime,
+                                     std::size_t begin, std::size_t end)
+{
+    // 1) Velocity: jump, gravity, accel/decel
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        bool onGround = grounded[i] != 0;
+        velocities[i] = UpdateVelocity(settings, moveDirections[i], jumps[i] != 0, deltaTime,
+                                       velocities[i], onGround);
+        grounded[i] = onGround ? 1 : 0;
+        jumps[i]    = 0;
+    }
+
+    if (!world)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            positions[i] = Vector3Add(positions[i], Vector3Scale(velocities[i], deltaTime));
+            grounded[i]  = 0;
+        }
+        return;
+    }
+
+    // 2) Swept moves with sliding
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        CharacterState state;
+        state.position = positions[i];
+        state.velocity = velocities[i];
+        MoveWithCollision(*world, colliders[i], localBoxes[i], Vector3Scale(velocities[i], deltaTime), state);
+        positions[i]  = state.position;
+        velocities[i] = state.velocity;
+    }
+
+    // 3) Ground probes for the agents not moving up, cast as one batch
+    Ray                rays[kAgentBatchSize];
+    const Collider*    ignore[kAgentBatchSize];
+    uint32_t           masks[kAgentBatchSize];
+    RaycastHit         hits[kAgentBatchSize];
+    std::size_t        probed[kAgentBatchSize];
+    int                rayCount = 0;
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        grounded[i] = 0;
+        if (velocities[i].y > 0.0f)
+            continue;
+
+        rays[rayCount]   = GroundProbeRay(localBoxes[i], positions[i]);
+        ignore[rayCount] = colliders[i];
+        masks[rayCount]  = QueryMask(*world, colliders[i]);
+        probed[rayCount] = i;
+        ++rayCount;
+    }
+
+    if (rayCount > 0)
+        world->RaycastBatch(rays, rayCount, kMaxProbeDistance, hits, ignore, masks);
+
+    for (int r = 0; r < rayCount; ++r)
+    {
+        const std::size_t i = probed[r];
+
+        CharacterState state;
+        state.position = positions[i];
+        state.velocity = velocities[i];
+        ResolveGround(hits[r].collider ? &hits[r] : nullptr, localBoxes[i], state);
+        positions[i]  = state.position;
+        velocities[i] = state.velocity;
+        grounded[i]   = state.grounded ? 1 : 0;
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+
+class PhysicsWorld;
+class Collider;
+
+// Movement tuning of a character (units per second, per second^2).
+struct CharacterSettings
+{
+    float moveSpeed   = 6.0f;    // maximum horizontal speed on ground and in air
+    float gravity     = -25.0f;  // constant vertical acceleration (negative = down)
+    float jumpSpeed   = 10.0f;   // upward velocity when a jump starts
+    float groundAccel = 40.0f;   // how fast we accelerate to max speed
+    float groundDecel = 80.0f;   // how fast we slow down when no input
+    float airAccel    = 10.0f;   // acceleration in air (range 0..groundAccel)
+    float airControl  = 0.6f;    // multiplier for how strong air control is (0..1+)
+};
+
+// Input for one fixed step, as plain data (keyboard, AI, replay...).
+struct CharacterCommand
+{
+    Vector3 moveDirection { 0.0f, 0.0f, 0.0f };  // world XZ direction, length 0..1
+    bool    jump      = false;                   // jump pressed since the last step
+    float   deltaTime = 0.0f;
+};
+
+// Simulated state of a character. position is the owning transform's position.
+struct CharacterState
+{
+    Vector3 position { 0.0f, 0.0f, 0.0f };
+    Vector3 velocity { 0.0f, 0.0f, 0.0f };
+    bool    grounded = false;
+};
+
+// One fixed step of the character movement model:
+// - Gravity and jumping, ground accel/decel, reduced air control.
+// - Swept box movement against the world: advances to the first contact, then
+//   slides the rest of the move along the contact normal (a few contacts per
+//   step). Side contacts level with the feet are stepped onto.
+// - A short downward raycast decides grounded and snaps out of shallow penetration.
+// localBox is the character's collider box relative to state.position; self
+// is skipped by every query. Without a world the character moves freely.
+// Only reads the world (safe off the main thread while nothing modifies it).
+void StepCharacter(const PhysicsWorld* world, const Collider* self, const BoundingBox& localBox,
+                   const CharacterSettings& settings, const CharacterCommand& command,
+                   CharacterState& state);
+
+// CharacterMotorSystem:
+// - Steps many characters (NPC crowds) with the same movement model as
+//   StepCharacter, for any kind of input (AI, network, replays).
+// - Agent data is kept as parallel arrays (structure of arrays), densely
+//   packed; agents are addressed by ids that stay valid until removed.
+// - Input is data: SetCommand() per agent, read by every following Step()
+//   (jump is consumed by one step).
+// - Step() splits the agents into batches across the JobSystem workers. Each
+//   batch runs the velocity pass over its arrays, the swept moves, then casts
+//   all of its ground probes with one PhysicsWorld::RaycastBatch.
+// - Queries see the world as of its last sync: agents that have colliders in
+//   it block each other at their synced (one step old) positions.
+class CharacterMotorSystem
+{
+public:
+    static constexpr int Null = -1;
+
+    explicit CharacterMotorSystem(const CharacterSettings& settings = CharacterSettings());
+
+    // localBox is the agent's box relative to its position; collider (optional)
+    // is its own collider in the world, skipped by its queries.
+    int  AddAgent(Vector3 position, const BoundingBox& localBox, const Collider* collider = nullptr);
+    void RemoveAgent(int agent);
+
+    int GetAgentCount() const { return static_cast<int>(positions.size()); }
+
+    void SetCommand(int agent, Vector3 moveDirection, bool jump = false);
+
+    CharacterState GetState(int agent) const;
+    void           SetPosition(int agent, Vector3 position);   // teleport
+
+    const CharacterSettings& GetSettings() const { return settings; }
+    void SetSettings(const CharacterSettings& value) { settings = value; }
+
+    // One fixed step for every agent. world may be null (no collisions).
+    void Step(const PhysicsWorld* world, float deltaTime);
+
+private:
+    CharacterSettings settings;
+
+    // Per agent, indexed by dense slot.
+    std::vector<Vector3>            positions;
+    std::vector<Vector3>            velocities;
+    std::vector<Vector3>            moveDirections;
+    std::vector<uint8_t>            jumps;
+    std::vector<uint8_t>            grounded;
+    std::vector<BoundingBox>        localBoxes;
+    std::vector<const Collider*> colliders;
+    std::vector<int>                slotAgents;   // slot -> agent id
+
+    std::vector<int> agentSlots;   // agent id -> slot (Null if free)
+    std::vector<int> freeAgents;
+
+    // Steps slots [begin, end) (at most one batch).
+    void StepBatch(const PhysicsWorld* world, float deltaTime, std::size_t begin, std::size_t end);
+};
@@ -0,0 +1,80 @@
+#include "Collider.h"
+#include "GameObject.h"
+#include "Transform3D.h"
+#include "SceneGraph.h"
+#include "PhysicsWorld.h"
+
+#include <cstdio>
+
+Collider::~Collider() {
+    if (physicsWorld) physicsWorld->RemoveCollider(this);
+}
+
+void Collider::OnShapeChanged() {
+    boundsDirty = true;
+    shapeChanged = true;
+    if (gameObject) gameObject->WakeUp();
+    if (isStatic && physicsWorld) physicsWorld->MarkStaticDirty();
+}
+
+void Collider::SetStatic(bool value) {
+    if (isStatic == value) return;
+
+    // Move between the world's static and dynamic sets.
+    PhysicsWorld* world = physicsWorld;
+    if (world) world->RemoveCollider(this);
+    isStatic = value;
+    if (world) world->AddCollider(this);
+}
+
+void Collider::SetTrigger(bool value) {
+    if (isTrigger == value) return;
+
+    // Triggers live apart from the solid colliders.
+    PhysicsWorld* world = physicsWorld;
+    if (world) world->RemoveCollider(this);
+    isTrigger = value;
+    if (world) world->AddCollider(this);
+}
+
+void Collider::SetLayer(int value) {
+    if (value < 0 || value >= PhysicsWorld::MaxLayers) {
+        std::printf("Collider: layer %d out of range on '%s'\n", value, gameObject->GetName().c_str());
+        return;
+    }
+    if (layer == value) return;
+
+    layer = value;
+    if (physicsWorld) physicsWorld->OnLayerChanged(this);
+}
+
+void Collider::Start() {
+    SceneGraph* graph = gameObject->GetSceneGraph();
+    if (graph && graph->GetPhysicsWorld())
+        graph->GetPhysicsWorld()->AddCollider(this);
+}
+
+BoundingBox Collider::GetBounds() const {
+    const uint32_t version = gameObject->GetTransform()->GetWorldVersion();
+    if (!boundsDirty && version == cachedVersion)
+        return cachedBounds;
+
+    cachedBounds = ComputeBounds();
+    cachedVersion = version;
+    boundsDirty = false;
+    return cachedBounds;
+}
+
+bool Collider::RaycastShape(const Ray& ray, float maxDistance, float& outDistance, Vector3& outNormal) const {
+    const RayCollision hit = GetRayCollisionBox(ray, syncedBounds);
+    if (!hit.hit || hit.distance > maxDistance) return false;
+    outDistance = hit.distance;
+    outNormal = hit.normal;
+    return true;
+}
+
+bool Collider::SweepShape(const BoundingBox& box, Vector3 displacement, float& outTime, Vector3& outNormal,
+                          float& outTop) const {
+    outTop = syncedBounds.max.y;
+    return PhysicsWorld::SweepBoxes(box, displacement, syncedBounds, outTime, outNormal);
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+#include "Component.h"
+
+class PhysicsWorld;
+
+// Collider:
+// - Base of every shape that joins the scene's PhysicsWorld (BoxCollider,
+//   MeshCollider). The world stores and queries colliders through this class.
+// - The broadphase only sees the world-space bounds (GetBounds). Shapes that
+//   do not fill their bounds refine hits in the narrow-phase hooks below.
+// - The narrow-phase hooks run inside PhysicsWorld queries, possibly on worker
+//   threads: they may only read the state captured by OnSync().
+class Collider : public Component {
+private:
+    bool isStatic = false;
+    bool isTrigger = false;
+    int  layer = 0;
+
+    // World bounds, rebuilt only when the transform's world version or the
+    // shape changed.
+    mutable BoundingBox cachedBounds {};
+    mutable uint32_t    cachedVersion = 0;
+    mutable bool        boundsDirty = true;
+
+    // Broadphase registration (managed by PhysicsWorld).
+    friend class PhysicsWorld;
+    PhysicsWorld* physicsWorld = nullptr;
+    int           proxyId = -1;
+    std::size_t   worldIndex = 0;        // in PhysicsWorld's list of all colliders
+    std::size_t   kindIndex = 0;         // in its static or dynamic list
+    uint32_t      syncedVersion = 0;     // transform world version at the last sync
+    BoundingBox   syncedBounds {};       // bounds at the last sync (what queries test)
+    bool          shapeChanged = false;  // shape changed since the last sync
+
+    // Trigger overlap cache (managed by PhysicsWorld): for a trigger the solid
+    // colliders inside it, for a solid collider the triggers it is inside.
+    std::vector<Collider*> triggerContacts;
+    bool          triggerQueryable = true;   // enabled and active at the last trigger test
+    bool          triggerQueued = false;     // waiting for a trigger test at the next sync
+    bool          triggerWatched = false;    // in the world's list checked for enable changes
+
+protected:
+    // False for shapes that only partly fill their bounds: queries then call
+    // the narrow-phase hooks instead of accepting a bounds hit.
+    bool fillsBounds = true;
+
+    // World-space bounds of the shape for the current transform.
+    virtual BoundingBox ComputeBounds() const = 0;
+
+    // Call after changing anything ComputeBounds() depends on (besides the transform).
+    void OnShapeChanged();
+
+    // Main thread, whenever PhysicsWorld records new bounds for this collider:
+    // capture whatever the narrow phase needs (e.g. the world matrix).
+    virtual void OnSync() {}
+
+    // Narrow phase, called for candidates whose synced bounds pass the broadphase.
+    // The defaults treat the shape as its bounds box.
+
+    // Ray (direction normalized) against the shape: distance and normal of the
+    // first hit within maxDistance.
+    virtual bool RaycastShape(const Ray& ray, float maxDistance, float& outDistance, Vector3& outNormal) const;
+
+    // Does the shape overlap box (which already overlaps the bounds)?
+    virtual bool OverlapsShape(const BoundingBox& box) const { return true; }
+
+    // Box moved by displacement against the shape (PhysicsWorld::SweepBoxes rules).
+    // outTop is the top (max y) of the part of the shape that was hit.
+    virtual bool SweepShape(const BoundingBox& box, Vector3 displacement, float& outTime, Vector3& outNormal,
+                            float& outTop) const;
+
+    const BoundingBox& GetSyncedBounds() const { return syncedBounds; }
+
+public:
+    ~Collider() override;
+
+    // Static colliders never move: PhysicsWorld bakes them into its static BVH
+    // and skips them when syncing. Move a static object only together with
+    // PhysicsWorld::MarkStaticDirty().
+    bool IsStatic() const { return isStatic; }
+    void SetStatic(bool value);
+
+    // Triggers never block and are skipped by every query. Their overlaps with
+    // solid colliders are tracked by the PhysicsWorld and reported to both
+    // objects as OnTriggerEnter / OnTriggerExit.
+    bool IsTrigger() const { return isTrigger; }
+    void SetTrigger(bool value);
+
+    // For a trigger: the solid colliders inside it; otherwise the triggers
+    // this collider is inside. As of the last PhysicsWorld sync.
+    const std::vector<Collider*>& GetTriggerOverlaps() const { return triggerContacts; }
+
+    // Collision layer, 0..31 (PhysicsWorld::MaxLayers). Which layers meet is
+    // decided by the world's layer matrix; queries take a mask of layer bits.
+    int      GetLayer() const { return layer; }
+    uint32_t GetLayerBit() const { return 1u << layer; }
+    void     SetLayer(int value);
+
+    BoundingBox GetBounds() const;
+
+    // Joins the scene's PhysicsWorld (if it has one).
+    void Start() override;
+};
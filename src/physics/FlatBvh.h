@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+#include "AabbTree.h"   // box helpers
+#include "RayPacket.h"
+
+// FlatBvh:
+// - The node hierarchy shared by the immutable trees (StaticBvh, TriangleBvh):
+//   built once, top-down (median split of the box centres along the axis they
+//   spread most), into one flat node array in depth-first order.
+// - It only knows item boxes and layer bits. Items are identified by their
+//   index in Build(); GetLeafOrder() lists them grouped by leaf, and leaves
+//   hand the owner a range of that list to test its own items against.
+// - Traversals use a fixed stack: depth stays far below 64 because every
+//   split halves the item range.
+class FlatBvh
+{
+public:
+    // Build over count items: boxOf(i) / layersOf(i) give item i's box and
+    // layer bits.
+    template <typename BoxFn, typename LayersFn>
+    void Build(int count, BoxFn&& boxOf, LayersFn&& layersOf);
+
+    template <typename BoxFn>
+    void Build(int count, BoxFn&& boxOf)
+    {
+        Build(count, boxOf, [](int) { return AabbTree::AllLayers; });
+    }
+
+    void Clear()
+    {
+        nodes.clear();
+        leafOrder.clear();
+    }
+
+    bool IsEmpty() const { return nodes.empty(); }
+    const BoundingBox& GetBounds() const { return nodes[0].box; }
+
+    // Item indices grouped by leaf; leaf ranges index into this.
+    const std::vector<int>& GetLeafOrder() const { return leafOrder; }
+
+    // Calls leaf(first, count) for every leaf in layerMask whose box overlaps
+    // box. leaf returns false to stop the query early.
+    template <typename LeafFn>
+    void Query(const BoundingBox& box, uint32_t layerMask, LeafFn&& leaf) const;
+
+    // Calls leaf(first, count, maxDistance) for every leaf in layerMask the ray
+    // enters within maxDistance, nearer subtrees first. leaf returns the new
+    // maxDistance (a hit shortens it), or a negative value to stop.
+    template <typename LeafFn>
+    void Raycast(const Ray& ray, float maxDistance, uint32_t layerMask, LeafFn&& leaf) const;
+
+    // Raycast for the rays of a packet in one walk: each node is tested against
+    // every lane at once. Calls leaf(first, count, lanes) with the lanes that
+    // reach the leaf; leaf shortens packet.maxDistance of the lanes it hits.
+    template <typename LeafFn>
+    void RaycastPacket(RayPacket& packet, LeafFn&& leaf) const;
+
+private:
+    static constexpr int kMaxLeafItems = 4;
+
+    // Leaves: count > 0, entries [first, first + count) of leafOrder.
+    // Inner nodes: count == 0, children are (this + 1) and first.
+    struct Node
+    {
+        BoundingBox box;
+        uint32_t    layers;   // union of the subtree's item layers
+        int         first;
+        int         count;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int>  leafOrder;
+
+    static float Centre(const BoundingBox& box, int axis)
+    {
+        switch (axis)
+        {
+        case 0:  return box.min.x + box.max.x;
+        case 1:  return box.min.y + box.max.y;
+        default: return box.min.z + box.max.z;
+        }
+    }
+
+    template <typename BoxFn, typename LayersFn>
+    int BuildNode(int begin, int end, BoxFn& boxOf, LayersFn& layersOf);
+};
+
+template <typename BoxFn, typename LayersFn>
+void FlatBvh::Build(int count, BoxFn&& boxOf, LayersFn&& layersOf)
+{
+    Clear();
+    if (count <= 0)
+        return;
+
+    leafOrder.resize(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+        leafOrder[i] = i;
+
+    // Leaves hold at least two items, so there are fewer than count nodes.
+    nodes.reserve(static_cast<std::size_t>(count));
+    BuildNode(0, count, boxOf, layersOf);
+}
+
+template <typename BoxFn, typename LayersFn>
+int FlatBvh::BuildNode(int begin, int end, BoxFn& boxOf, LayersFn& layersOf)
+{
+    const int index = static_cast<int>(nodes.size());
+    nodes.push_back(Node());
+
+    BoundingBox bounds = boxOf(leafOrder[begin]);
+    uint32_t    layers = layersOf(leafOrder[begin]);
+    float cMin[3] = { Centre(bounds, 0), Centre(bounds, 1), Centre(bounds, 2) };
+    float cMax[3] = { cMin[0], cMin[1], cMin[2] };
+
+    for (int i = begin + 1; i < end; ++i)
+    {
+        const BoundingBox box = boxOf(leafOrder[i]);
+        bounds  = AabbTree::Union(bounds, box);
+        layers |= layersOf(leafOrder[i]);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float c = Centre(box, axis);
+            cMin[axis] = std::min(cMin[axis], c);
+            cMax[axis] = std::max(cMax[axis], c);
+        }
+    }
+
+    nodes[index].box    = bounds;
+    nodes[index].layers = layers;
+
+    const int count = end - begin;
+    if (count <= kMaxLeafItems)
+    {
+        nodes[index].first = begin;
+        nodes[index].count = count;
+        return index;
+    }
+
+    int axis = 0;
+    if (cMax[1] - cMin[1] > cMax[axis] - cMin[axis]) axis = 1;
+    if (cMax[2] - cMin[2] > cMax[axis] - cMin[axis]) axis = 2;
+
+    const int mid = begin + count / 2;
+    std::nth_element(leafOrder.begin() + begin, leafOrder.begin() + mid, leafOrder.begin() + end,
+        [&boxOf, axis](int a, int b)
+        {
+            return Centre(boxOf(a), axis) < Centre(boxOf(b), axis);
+        });
+
+    // The first child is built next, so it lands right after its parent.
+    BuildNode(begin, mid, boxOf, layersOf);
+    const int second = BuildNode(mid, end, boxOf, layersOf);
+
+    nodes[index].first = second;
+    nodes[index].count = 0;
+    return index;
+}
+
+template <typename LeafFn>
+void FlatBvh::Query(const BoundingBox& box, uint32_t layerMask, LeafFn&& leaf) const
+{
+    if (nodes.empty())
+        return;
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const int   index = stack[--top];
+        const Node& node  = nodes[index];
+        if (!(node.layers & layerMask) || !AabbTree::Overlaps(node.box, box))
+            continue;
+
+        if (node.count > 0)
+        {
+            if (!leaf(node.first, node.count))
+                return;
+        }
+        else
+        {
+            stack[top++] = index + 1;
+            stack[top++] = node.first;
+        }
+    }
+}
+
+template <typename LeafFn>
+void FlatBvh::Raycast(const Ray& ray, float maxDistance, uint32_t layerMask, LeafFn&& leaf) const
+{
+    if (nodes.empty())
+        return;
+
+    const Vector3 invDir = {
+        1.0f / ray.direction.x,
+        1.0f / ray.direction.y,
+        1.0f / ray.direction.z
+    };
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    float entry;
+    while (top > 0)
+    {
+        const int   index = stack[--top];
+        const Node& node  = nodes[index];
+        if (!(node.layers & layerMask) ||
+            !AabbTree::RayEntersBox(ray.position, invDir, node.box, maxDistance, entry))
+            continue;
+
+        if (node.count > 0)
+        {
+            maxDistance = leaf(node.first, node.count, maxDistance);
+            if (maxDistance < 0.0f)
+                return;
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is visited first
+        // (a close hit then prunes the far side).
+        float nearA, nearB;
+        const bool hitA = AabbTree::RayEntersBox(ray.position, invDir, nodes[index + 1].box, maxDistance, nearA);
+        const bool hitB = AabbTree::RayEntersBox(ray.position, invDir, nodes[node.first].box, maxDistance, nearB);
+        if (hitA && hitB)
+        {
+            stack[top++] = nearA <= nearB ? node.first : index + 1;
+            stack[top++] = nearA <= nearB ? index + 1 : node.first;
+        }
+        else if (hitA)
+        {
+            stack[top++] = index + 1;
+        }
+        else if (hitB)
+        {
+            stack[top++] = node.first;
+        }
+    }
+}
+
+template <typename LeafFn>
+void FlatBvh::RaycastPacket(RayPacket& packet, LeafFn&& leaf) const
+{
+    if (nodes.empty())
+        return;
+
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    float entry[RayPacket::Lanes];
+    while (top > 0)
+    {
+        const int   index = stack[--top];
+        const Node& node  = nodes[index];
+        int lanes = packet.LayerLanes(node.layers);
+        if (!lanes || !(lanes &= packet.Enters(node.box, entry)))
+            continue;
+
+        if (node.count > 0)
+        {
+            leaf(node.first, node.count, lanes);
+            if (!packet.ActiveLanes())
+                return;
+            continue;
+        }
+
+        // As in Raycast, the child nearest to any lane is visited first.
+        float nearA, nearB;
+        const bool hitA = packet.EntersNearest(nodes[index + 1].box, nearA) != 0;
+        const bool hitB = packet.EntersNearest(nodes[node.first].box, nearB) != 0;
+        if (hitA && hitB)
+        {
+            stack[top++] = nearA <= nearB ? node.first : index + 1;
+            stack[top++] = nearA <= nearB ? index + 1 : node.first;
+        }
+        else if (hitA)
+        {
+            stack[top++] = index + 1;
+        }
+        else if (hitB)
+        {
+            stack[top++] = node.first;
+        }
+    }
+}
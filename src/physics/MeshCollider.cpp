@@ -0,0 +1,230 @@
+#include "MeshCollider.h"
+#include "TriangleBvh.h"
+#include "PhysicsWorld.h"
+#include "GameObject.h"
+#include "Transform3D.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+namespace
+{
+    BoundingBox TransformBox(const BoundingBox& box, const Matrix& m)
+    {
+        BoundingBox result;
+        for (int i = 0; i < 8; ++i)
+        {
+            const Vector3 corner = {
+                (i & 1) ? box.max.x : box.min.x,
+                (i & 2) ? box.max.y : box.min.y,
+                (i & 4) ? box.max.z : box.min.z
+            };
+            const Vector3 p = Vector3Transform(corner, m);
+            if (i == 0)
+            {
+                result = { p, p };
+                continue;
+            }
+            result.min = Vector3Min(result.min, p);
+            result.max = Vector3Max(result.max, p);
+        }
+        return result;
+    }
+
+    // Direction (no translation) through the upper 3x3 of m.
+    Vector3 TransformDirection(Vector3 v, const Matrix& m)
+    {
+        return {
+            m.m0 * v.x + m.m4 * v.y + m.m8  * v.z,
+            m.m1 * v.x + m.m5 * v.y + m.m9  * v.z,
+            m.m2 * v.x + m.m6 * v.y + m.m10 * v.z
+        };
+    }
+
+    // Do the projections of the triangle (v0..v2, relative to the box centre)
+    // and of the box (half extents h) onto axis overlap?
+    bool OverlapOnAxis(Vector3 axis, Vector3 v0, Vector3 v1, Vector3 v2, Vector3 h)
+    {
+        const float p0 = Vector3DotProduct(v0, axis);
+        const float p1 = Vector3DotProduct(v1, axis);
+        const float p2 = Vector3DotProduct(v2, axis);
+        const float r  = h.x * std::fabs(axis.x) + h.y * std::fabs(axis.y) + h.z * std::fabs(axis.z);
+        return std::max(p0, std::max(p1, p2)) >= -r && std::min(p0, std::min(p1, p2)) <= r;
+    }
+
+    // Separating axis test (box face normals, triangle normal, 9 edge cross products).
+    bool TriangleOverlapsBox(Vector3 a, Vector3 b, Vector3 c, const BoundingBox& box)
+    {
+        const Vector3 centre = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+        const Vector3 h      = Vector3Scale(Vector3Subtract(box.max, box.min), 0.5f);
+
+        const Vector3 v0 = Vector3Subtract(a, centre);
+        const Vector3 v1 = Vector3Subtract(b, centre);
+        const Vector3 v2 = Vector3Subtract(c, centre);
+
+        // Box faces: the triangle's bounds against the box.
+        if (std::max(v0.x, std::max(v1.x, v2.x)) < -h.x || std::min(v0.x, std::min(v1.x, v2.x)) > h.x) return false;
+        if (std::max(v0.y, std::max(v1.y, v2.y)) < -h.y || std::min(v0.y, std::min(v1.y, v2.y)) > h.y) return false;
+        if (std::max(v0.z, std::max(v1.z, v2.z)) < -h.z || std::min(v0.z, std::min(v1.z, v2.z)) > h.z) return false;
+
+        const Vector3 edges[3] = {
+            Vector3Subtract(v1, v0),
+            Vector3Subtract(v2, v1),
+            Vector3Subtract(v0, v2)
+        };
+
+        if (!OverlapOnAxis(Vector3CrossProduct(edges[0], edges[1]), v0, v1, v2, h))
+            return false;
+
+        const Vector3 boxAxes[3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+        for (const Vector3& edge : edges)
+        {
+            for (const Vector3& boxAxis : boxAxes)
+            {
+                if (!OverlapOnAxis(Vector3CrossProduct(boxAxis, edge), v0, v1, v2, h))
+                    return false;
+            }
+        }
+        return true;
+    }
+}
+
+MeshCollider::MeshCollider(bool visible)
+    : visible(visible)
+{
+    fillsBounds = false;
+    world = MatrixIdentity();
+    inverseWorld = MatrixIdentity();
+}
+
+MeshCollider::~MeshCollider() = default;
+
+int MeshCollider::GetTriangleCount() const
+{
+    return bvh ? bvh->GetTriangleCount() : 0;
+}
+
+void MeshCollider::SetModelSource(ModelSource source, const std::string& key)
+{
+    modelSource = std::move(source);
+    modelKey    = key;
+}
+
+void MeshCollider::Start()
+{
+    const Model* model = modelSource ? modelSource() : nullptr;
+    if (!model)
+    {
+        std::printf("MeshCollider: '%s' has no model, collider disabled\n",
+                    gameObject->GetName().c_str());
+        return;
+    }
+
+    bvh = TriangleBvh::Acquire(*model, modelKey);
+    OnShapeChanged();
+    Collider::Start();
+}
+
+BoundingBox MeshCollider::ComputeBounds() const
+{
+    const Matrix& m = gameObject->GetTransform()->GetWorldMatrix();
+    if (!bvh || bvh->GetTriangleCount() == 0)
+    {
+        const Vector3 origin = { m.m12, m.m13, m.m14 };
+        return { origin, origin };
+    }
+    return TransformBox(bvh->GetBounds(), m);
+}
+
+void MeshCollider::OnSync()
+{
+    world        = gameObject->GetTransform()->GetWorldMatrix();
+    inverseWorld = MatrixInvert(world);
+}
+
+BoundingBox MeshCollider::ToLocal(const BoundingBox& box) const
+{
+    return TransformBox(box, inverseWorld);
+}
+
+bool MeshCollider::RaycastShape(const Ray& ray, float maxDistance, float& outDistance, Vector3& outNormal) const
+{
+    if (!bvh)
+        return false;
+
+    // An affine map keeps the ray parameter: with the direction left
+    // unnormalized, the local t is the world distance.
+    const Ray local = {
+        Vector3Transform(ray.position, inverseWorld),
+        TransformDirection(ray.direction, inverseWorld)
+    };
+
+    float   t;
+    Vector3 normal;
+    if (!bvh->Raycast(local, maxDistance, t, normal))
+        return false;
+
+    // Normals go through the inverse transpose.
+    const Matrix normalMatrix = MatrixTranspose(inverseWorld);
+    outNormal   = Vector3Normalize(TransformDirection(normal, normalMatrix));
+    outDistance = t;
+    return true;
+}
+
+bool MeshCollider::OverlapsShape(const BoundingBox& box) const
+{
+    if (!bvh)
+        return false;
+
+    bool overlaps = false;
+    bvh->Query(ToLocal(box), [&](const TriangleBvh::Triangle& t)
+    {
+        overlaps = TriangleOverlapsBox(Vector3Transform(t.a, world), Vector3Transform(t.b, world),
+                                       Vector3Transform(t.c, world), box);
+        return !overlaps;
+    });
+    return overlaps;
+}
+
+bool MeshCollider::SweepShape(const BoundingBox& box, Vector3 displacement, float& outTime, Vector3& outNormal,
+                              float& outTop) const
+{
+    if (!bvh)
+        return false;
+
+    const BoundingBox moved = { Vector3Add(box.min, displacement), Vector3Add(box.max, displacement) };
+    const BoundingBox swept = AabbTree::Union(box, moved);
+
+    bool found = false;
+    outTime = 1.0f;
+
+    bvh->Query(ToLocal(swept), [&](const TriangleBvh::Triangle& t)
+    {
+        const Vector3 a = Vector3Transform(t.a, world);
+        const Vector3 b = Vector3Transform(t.b, world);
+        const Vector3 c = Vector3Transform(t.c, world);
+        const BoundingBox triangleBox = { Vector3Min(Vector3Min(a, b), c), Vector3Max(Vector3Max(a, b), c) };
+
+        float   time;
+        Vector3 normal;
+        if (PhysicsWorld::SweepBoxes(box, displacement, triangleBox, time, normal) && time < outTime)
+        {
+            outTime   = time;
+            outNormal = normal;
+            outTop    = triangleBox.max.y;   // this triangle, not the whole mesh
+            found     = true;
+        }
+        return true;
+    });
+
+    return found;
+}
+
+void MeshCollider::Draw()
+{
+    if (!visible) return;
+    DrawBoundingBox(GetBounds(), GREEN);
+}
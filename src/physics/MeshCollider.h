@@ -0,0 +1,68 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "raylib.h"
+#include "Collider.h"
+
+class TriangleBvh;
+
+// MeshCollider:
+// - Collides with the triangles of a model (level geometry, props too
+//   irregular for a box). The model comes from a source set by the game layer
+//   (see UseMeshFilterGeometry in SceneComponents.h); physics does not know
+//   about rendering components.
+// - The triangles live in a TriangleBvh shared by every collider of the same
+//   asset; the collider only keeps its world matrix, captured when the
+//   PhysicsWorld syncs it.
+// - Raycasts and overlaps are exact against the triangles. Box sweeps treat
+//   each triangle as its world-space bounds box: exact for axis-aligned
+//   faces, conservative (stops a little early) on slopes.
+// - Best used on static objects (SetStatic(true)); moving ones work but
+//   recompute their bounds from the tree's 8 corners every sync.
+class MeshCollider : public Collider {
+public:
+    // Asked for the model in Start(); nullptr if there is none (yet).
+    using ModelSource = std::function<const Model*()>;
+
+private:
+    ModelSource modelSource;
+    std::string modelKey;
+
+    std::shared_ptr<const TriangleBvh> bvh;
+    bool visible = false;
+
+    // Captured in OnSync() for the narrow phase.
+    Matrix world {};
+    Matrix inverseWorld {};
+
+    // World box -> bounds of it in model space (for tree queries).
+    BoundingBox ToLocal(const BoundingBox& box) const;
+
+protected:
+    BoundingBox ComputeBounds() const override;
+    void OnSync() override;
+
+    bool RaycastShape(const Ray& ray, float maxDistance, float& outDistance, Vector3& outNormal) const override;
+    bool OverlapsShape(const BoundingBox& box) const override;
+    bool SweepShape(const BoundingBox& box, Vector3 displacement, float& outTime, Vector3& outNormal,
+                    float& outTop) const override;
+
+public:
+    explicit MeshCollider(bool visible = false);
+    ~MeshCollider() override;
+
+    bool IsVisible() const { return visible; }
+    int GetTriangleCount() const;
+
+    // Geometry to collide with, resolved in Start(). key identifies it for
+    // sharing the triangle tree (usually the model path; empty: shared per
+    // Model instance).
+    void SetModelSource(ModelSource source, const std::string& key);
+
+    // Builds (or shares) the triangle tree, then joins the scene's PhysicsWorld.
+    void Start() override;
+    void Draw() override;
+};
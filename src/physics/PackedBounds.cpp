@@ -0,0 +1,96 @@
+#include "PackedBounds.h"
+
+#include <limits>
+
+namespace
+{
+    // Padding lanes: min = max = +inf, which no ray or box can reach.
+    const float kEmpty = std::numeric_limits<float>::infinity();
+}
+
+void PackedBounds::Clear()
+{
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+    layerBits.clear();
+    count = 0;
+}
+
+void PackedBounds::Reserve(int capacity)
+{
+    const std::size_t padded = static_cast<std::size_t>((capacity + Lanes - 1) / Lanes * Lanes);
+    minX.reserve(padded); minY.reserve(padded); minZ.reserve(padded);
+    maxX.reserve(padded); maxY.reserve(padded); maxZ.reserve(padded);
+    layerBits.reserve(padded);
+}
+
+int PackedBounds::Add(const BoundingBox& box, uint32_t layers)
+{
+    // Grow by a whole block of empty lanes when the last one is full.
+    if (count % Lanes == 0)
+    {
+        const std::size_t padded = static_cast<std::size_t>(count + Lanes);
+        minX.resize(padded, kEmpty); minY.resize(padded, kEmpty); minZ.resize(padded, kEmpty);
+        maxX.resize(padded, kEmpty); maxY.resize(padded, kEmpty); maxZ.resize(padded, kEmpty);
+        layerBits.resize(padded, 0u);
+    }
+
+    const int index = count++;
+    Set(index, box);
+    layerBits[index] = layers;
+    return index;
+}
+
+void PackedBounds::Set(int index, const BoundingBox& box)
+{
+    minX[index] = box.min.x; minY[index] = box.min.y; minZ[index] = box.min.z;
+    maxX[index] = box.max.x; maxY[index] = box.max.y; maxZ[index] = box.max.z;
+}
+
+void PackedBounds::Remove(int index)
+{
+    const int last = count - 1;
+    if (index != last)
+    {
+        Set(index, Get(last));
+        layerBits[index] = layerBits[last];
+    }
+
+    // The freed lane becomes padding; drop the block once it is all padding.
+    minX[last] = minY[last] = minZ[last] = kEmpty;
+    maxX[last] = maxY[last] = maxZ[last] = kEmpty;
+    layerBits[last] = 0u;
+    --count;
+
+    if (count % Lanes == 0)
+    {
+        const std::size_t padded = static_cast<std::size_t>(count);
+        minX.resize(padded); minY.resize(padded); minZ.resize(padded);
+        maxX.resize(padded); maxY.resize(padded); maxZ.resize(padded);
+        layerBits.resize(padded);
+    }
+}
+
+BoundingBox PackedBounds::Get(int index) const
+{
+    return {
+        { minX[index], minY[index], minZ[index] },
+        { maxX[index], maxY[index], maxZ[index] }
+    };
+}
+
+PackedBounds::RayData PackedBounds::MakeRayData(const Ray& ray)
+{
+    const float dir[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+
+    RayData data;
+    data.origin[0] = ray.position.x;
+    data.origin[1] = ray.position.y;
+    data.origin[2] = ray.position.z;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        data.parallel[axis] = dir[axis] == 0.0f;
+        data.invDir[axis]   = data.parallel[axis] ? 0.0f : 1.0f / dir[axis];
+    }
+    return data;
+}
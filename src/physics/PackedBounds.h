@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+
+// Build flag: set to 0 (e.g. CFLAGS += -DPACKED_BOUNDS_SIMD=0) to use the
+// scalar loops instead of the SSE kernels. On by default wherever SSE2 is.
+#ifndef PACKED_BOUNDS_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PACKED_BOUNDS_SIMD 1
+#else
+#define PACKED_BOUNDS_SIMD 0
+#endif
+#endif
+
+#if PACKED_BOUNDS_SIMD
+#include <emmintrin.h>
+#endif
+
+// PackedBounds:
+// - A list of boxes stored as six float arrays (structure of arrays), padded to
+//   a multiple of 4 with empty boxes that nothing can hit.
+// - Ray and box queries test 4 boxes per instruction (SSE slab test), so a
+//   linear scan of a few hundred boxes costs about as much as a tree walk and
+//   needs no maintenance beyond Set().
+// - Indices are dense: Remove() moves the last box into the freed index.
+// - A seventh array holds each box's layer bits; queries mask a block of 4
+//   by layer first and skip the slab test when no lane is left.
+class PackedBounds
+{
+public:
+    static constexpr int      Lanes     = 4;
+    static constexpr uint32_t AllLayers = 0xFFFFFFFFu;
+
+    void Clear();
+    void Reserve(int count);
+
+    int  Add(const BoundingBox& box, uint32_t layers = AllLayers);   // returns the new index
+    void Set(int index, const BoundingBox& box);
+    void SetLayers(int index, uint32_t layers) { layerBits[index] = layers; }
+    void Remove(int index);                          // swap-remove with the last box
+
+    BoundingBox Get(int index) const;
+    uint32_t    GetLayers(int index) const { return layerBits[index]; }
+    int         Size() const { return count; }
+
+    // The six arrays at block base (a multiple of Lanes), for kernels that
+    // test the boxes against something other than a ray or a box (e.g. the
+    // frustum planes in FrustumCuller). Lanes past Size() are padding.
+    struct Block
+    {
+        const float* lo[3];   // min x, y, z of lanes base .. base + 3
+        const float* hi[3];   // max x, y, z
+    };
+
+    Block GetBlock(int base) const
+    {
+        return {
+            { &minX[base], &minY[base], &minZ[base] },
+            { &maxX[base], &maxY[base], &maxZ[base] }
+        };
+    }
+
+    // Calls fn(index, entryDistance) for every box in layerMask the ray (direction
+    // normalized) enters within maxDistance; the entry distance is 0 if the ray
+    // starts inside. fn returns the new maxDistance (the hit distance to keep
+    // only closer ones), or a negative value to stop.
+    template <typename Fn>
+    void Raycast(const Ray& ray, float maxDistance, Fn&& fn, uint32_t layerMask = AllLayers) const;
+
+    // Calls fn(index) for every box in layerMask overlapping box (touching counts).
+    // fn returns false to stop early.
+    template <typename Fn>
+    void Query(const BoundingBox& box, Fn&& fn, uint32_t layerMask = AllLayers) const;
+
+private:
+    std::vector<float>    minX, minY, minZ;
+    std::vector<float>    maxX, maxY, maxZ;
+    std::vector<uint32_t> layerBits;   // padding lanes: 0, in no layer
+    int                   count = 0;
+
+    // Per-ray constants shared by every block.
+    struct RayData
+    {
+        float origin[3];
+        float invDir[3];
+        bool  parallel[3];   // direction is 0 on this axis
+    };
+
+    static RayData MakeRayData(const Ray& ray);
+
+    // Lane i of the result is set if box (base + i) is hit; writes entry distances.
+    int RayBlock(const RayData& ray, int base, float maxDistance, float entry[Lanes]) const;
+    int OverlapBlock(const BoundingBox& box, int base) const;
+
+    // Lane i of the result is set if box (base + i) is in a layer of layerMask.
+    int LayerBlock(int base, uint32_t layerMask) const;
+};
+
+inline int PackedBounds::LayerBlock(int base, uint32_t layerMask) const
+{
+#if PACKED_BOUNDS_SIMD
+    const __m128i bits = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&layerBits[base])),
+                                       _mm_set1_epi32(static_cast<int>(layerMask)));
+    const __m128i none = _mm_cmpeq_epi32(bits, _mm_setzero_si128());
+    return ~_mm_movemask_ps(_mm_castsi128_ps(none)) & 0xF;
+#else
+    int mask = 0;
+    for (int lane = 0; lane < Lanes; ++lane)
+    {
+        if (layerBits[base + lane] & layerMask)
+            mask |= 1 << lane;
+    }
+    return mask;
+#endif
+}
+
+inline int PackedBounds::RayBlock(const RayData& ray, int base, float maxDistance, float entry[Lanes]) const
+{
+    const Block  block = GetBlock(base);
+    const float* const* lo = block.lo;
+    const float* const* hi = block.hi;
+
+#if PACKED_BOUNDS_SIMD
+    __m128 tNear = _mm_setzero_ps();
+    __m128 tFar  = _mm_set1_ps(maxDistance);
+    __m128 ok    = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const __m128 boxLo = _mm_loadu_ps(lo[axis]);
+        const __m128 boxHi = _mm_loadu_ps(hi[axis]);
+        const __m128 o     = _mm_set1_ps(ray.origin[axis]);
+
+        if (ray.parallel[axis])
+        {
+            // Parallel to the slab: inside it or never (avoids 0 * inf = NaN).
+            ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmpge_ps(o, boxLo), _mm_cmple_ps(o, boxHi)));
+            continue;
+        }
+
+        const __m128 inv = _mm_set1_ps(ray.invDir[axis]);
+        const __m128 t1  = _mm_mul_ps(_mm_sub_ps(boxLo, o), inv);
+        const __m128 t2  = _mm_mul_ps(_mm_sub_ps(boxHi, o), inv);
+        tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+        tFar  = _mm_min_ps(tFar,  _mm_max_ps(t1, t2));
+    }
+
+    ok = _mm_and_ps(ok, _mm_cmple_ps(tNear, tFar));
+    _mm_storeu_ps(entry, tNear);
+    return _mm_movemask_ps(ok);
+#else
+    int mask = 0;
+    for (int lane = 0; lane < Lanes; ++lane)
+    {
+        float tNear = 0.0f;
+        float tFar  = maxDistance;
+        bool  ok    = true;
+        for (int axis = 0; axis < 3 && ok; ++axis)
+        {
+            const float o = ray.origin[axis];
+            if (ray.parallel[axis])
+            {
+                ok = o >= lo[axis][lane] && o <= hi[axis][lane];
+                continue;
+            }
+
+            float t1 = (lo[axis][lane] - o) * ray.invDir[axis];
+            float t2 = (hi[axis][lane] - o) * ray.invDir[axis];
+            if (t1 > t2) { const float t = t1; t1 = t2; t2 = t; }
+            if (t1 > tNear) tNear = t1;
+            if (t2 < tFar)  tFar  = t2;
+        }
+
+        entry[lane] = tNear;
+        if (ok && tNear <= tFar)
+            mask |= 1 << lane;
+    }
+    return mask;
+#endif
+}
+
+inline int PackedBounds::OverlapBlock(const BoundingBox& box, int base) const
+{
+#if PACKED_BOUNDS_SIMD
+    __m128 ok = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minX[base]), _mm_set1_ps(box.max.x)),
+                           _mm_cmpge_ps(_mm_loadu_ps(&maxX[base]), _mm_set1_ps(box.min.x)));
+    ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minY[base]), _mm_set1_ps(box.max.y)),
+                                   _mm_cmpge_ps(_mm_loadu_ps(&maxY[base]), _mm_set1_ps(box.min.y))));
+    ok = _mm_and_ps(ok, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&minZ[base]), _mm_set1_ps(box.max.z)),
+                                   _mm_cmpge_ps(_mm_loadu_ps(&maxZ[base]), _mm_set1_ps(box.min.z))));
+    return _mm_movemask_ps(ok);
+#else
+    int mask = 0;
+    for (int lane = 0; lane < Lanes; ++lane)
+    {
+        const int i = base + lane;
+        if (minX[i] <= box.max.x && maxX[i] >= box.min.x &&
+            minY[i] <= box.max.y && maxY[i] >= box.min.y &&
+            minZ[i] <= box.max.z && maxZ[i] >= box.min.z)
+            mask |= 1 << lane;
+    }
+    return mask;
+#endif
+}
+
+template <typename Fn>
+void PackedBounds::Raycast(const Ray& ray, float maxDistance, Fn&& fn, uint32_t layerMask) const
+{
+    const RayData data = MakeRayData(ray);
+    float entry[Lanes];
+
+    for (int base = 0; base < count; base += Lanes)
+    {
+        const int layers = LayerBlock(base, layerMask);
+        if (!layers)
+            continue;
+
+        const int mask = RayBlock(data, base, maxDistance, entry) & layers;
+        if (!mask)
+            continue;
+
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            // An earlier lane of this block may have shortened the search.
+            if (!(mask & (1 << lane)) || entry[lane] > maxDistance)
+                continue;
+
+            maxDistance = fn(base + lane, entry[lane]);
+            if (maxDistance < 0.0f)
+                return;
+        }
+    }
+}
+
+template <typename Fn>
+void PackedBounds::Query(const BoundingBox& box, Fn&& fn, uint32_t layerMask) const
+{
+    for (int base = 0; base < count; base += Lanes)
+    {
+        const int layers = LayerBlock(base, layerMask);
+        if (!layers)
+            continue;
+
+        const int mask = OverlapBlock(box, base) & layers;
+        if (!mask)
+            continue;
+
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            if ((mask & (1 << lane)) && !fn(base + lane))
+                return;
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#include "PhysicsStage.h"
+#include "PhysicsWorld.h"
+
+PhysicsStage::PhysicsStage(PhysicsWorld& physicsWorld)
+    : world(physicsWorld)
+{
+}
+
+PhysicsStage::~PhysicsStage()
+{
+    // The worker reads the world and our bodies: never free them under it.
+    Sync();
+}
+
+int PhysicsStage::CreateBody(const Collider* collider, const CharacterState& state)
+{
+    int body;
+    if (!freeBodies.empty())
+    {
+        body = freeBodies.back();
+        freeBodies.pop_back();
+    }
+    else
+    {
+        body = static_cast<int>(bodies.size());
+        bodies.emplace_back();
+    }
+
+    Body& b    = bodies[body];
+    b          = Body();
+    b.collider = collider;
+    b.state    = state;
+    b.alive    = true;
+    return body;
+}
+
+void PhysicsStage::DestroyBody(int body)
+{
+    if (body < 0 || body >= static_cast<int>(bodies.size()) || !bodies[body].alive)
+        return;
+
+    bodies[body] = Body();
+    freeBodies.push_back(body);
+}
+
+void PhysicsStage::SetSettings(int body, const CharacterSettings& settings)
+{
+    bodies[body].settings = settings;
+}
+
+void PhysicsStage::SetLocalBox(int body, const BoundingBox& localBox)
+{
+    bodies[body].localBox = localBox;
+}
+
+void PhysicsStage::Submit(int body, const CharacterCommand& command)
+{
+    bodies[body].pending.push_back(command);
+}
+
+bool PhysicsStage::PopState(int body, CharacterState& outState)
+{
+    Body& b = bodies[body];
+    if (b.published.empty())
+        return false;
+
+    outState = b.published.front();
+    b.published.pop_front();
+    return true;
+}
+
+void PhysicsStage::Sync()
+{
+    if (!running)
+        return;
+
+    if (JobSystem* jobs = JobSystem::Get())
+        jobs->Wait(job);
+    job     = JobHandle();
+    running = false;
+
+    // Swap: the worker's results become readable on the main thread. States of
+    // the previous frame still unconsumed (it ran more steps than this one) are
+    // dropped: the new results are newer, and keeping them would leave the body
+    // that many steps behind its input from now on.
+    for (Body& b : bodies)
+    {
+        if (!b.alive)
+            continue;
+        if (!b.results.empty())
+            b.published.assign(b.results.begin(), b.results.end());
+        b.results.clear();
+        b.inFlight.clear();
+    }
+}
+
+void PhysicsStage::Kick()
+{
+    if (running)
+        return;
+
+    bool any = false;
+    for (Body& b : bodies)
+    {
+        if (!b.alive || b.pending.empty())
+            continue;
+        b.inFlight.swap(b.pending);
+        any = true;
+    }
+    if (!any)
+        return;
+
+    running = true;
+
+    // Without worker threads, simulate now and publish at the next Sync().
+    JobSystem* jobs = JobSystem::Get();
+    if (jobs && jobs->GetWorkerCount() > 0)
+        job = jobs->Schedule([this]() { Simulate(); });
+    else
+        Simulate();
+}
+
+void PhysicsStage::Simulate()
+{
+    for (Body& b : bodies)
+    {
+        if (!b.alive)
+            continue;
+
+        for (const CharacterCommand& command : b.inFlight)
+        {
+            StepCharacter(&world, b.collider, b.localBox, b.settings, command, b.state);
+            b.results.push_back(b.state);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "raylib.h"
+#include "JobSystem.h"
+#include "CharacterMotor.h"
+
+class PhysicsWorld;
+class Collider;
+
+// PhysicsStage:
+// - Runs character movement (StepCharacter) for registered bodies on a worker
+//   thread, so collision resolution overlaps with rendering instead of running
+//   inside the components' Update.
+// - The frame is split in two phases:
+//     Sync() .. Kick()   main thread: gameplay submits one command per body and
+//                        fixed step, consumes published states, syncs the world.
+//     Kick() .. Sync()   worker: simulates every submitted step against the
+//                        PhysicsWorld as of the last sync, writing the results
+//                        into a back buffer. The main thread renders meanwhile
+//                        and must not modify the world or call the stage.
+// - Sync() (frame start) waits for the worker and publishes the back buffer.
+//   Results come back one per submitted step, one frame later; popping one per
+//   fixed step keeps render interpolation smooth. Publishing replaces whatever
+//   the previous frame left unconsumed, so latency stays at most one frame
+//   even after a frame that ran more steps than the next.
+// - Without worker threads Kick() simulates right away (same results).
+class PhysicsStage
+{
+public:
+    static constexpr int Null = -1;
+
+    explicit PhysicsStage(PhysicsWorld& world);
+    ~PhysicsStage();
+
+    PhysicsStage(const PhysicsStage&) = delete;
+    PhysicsStage& operator=(const PhysicsStage&) = delete;
+
+    // A character moved by the stage. collider is its own collider (skipped by
+    // its queries); state is where the simulation starts.
+    int  CreateBody(const Collider* collider, const CharacterState& state);
+    void DestroyBody(int body);
+
+    // Movement tuning and collider box (relative to the body position) used by
+    // the next simulated steps.
+    void SetSettings(int body, const CharacterSettings& settings);
+    void SetLocalBox(int body, const BoundingBox& localBox);
+
+    // Queue one fixed step of input. Call once per body per fixed step.
+    void Submit(int body, const CharacterCommand& command);
+
+    // Oldest published state not yet consumed (one per step submitted in the
+    // previous frame). Returns false if none is available yet.
+    bool PopState(int body, CharacterState& outState);
+
+    // Frame start: wait for the worker, then publish its results.
+    void Sync();
+
+    // After the frame's fixed steps: simulate everything submitted since the
+    // last Kick() on a worker (no-op if nothing was submitted).
+    void Kick();
+
+    bool IsRunning() const { return running; }
+
+private:
+    struct Body
+    {
+        const Collider*               collider = nullptr;
+        BoundingBox                   localBox {};
+        CharacterSettings             settings;
+        CharacterState                state;       // simulation side: after the last simulated step
+        std::vector<CharacterCommand> pending;     // submitted since the last Kick()
+        std::vector<CharacterCommand> inFlight;    // being simulated
+        std::vector<CharacterState>   results;     // back buffer (written by the worker)
+        std::deque<CharacterState>    published;   // front buffer (consumed by PopState)
+        bool                          alive = false;
+    };
+
+    PhysicsWorld&     world;
+    std::vector<Body> bodies;
+    std::vector<int>  freeBodies;
+    JobHandle         job;
+    bool              running = false;
+
+    // Worker side: run every in-flight command of every body.
+    void Simulate();
+};
@@ -0,0 +1,890 @@
+#include "PhysicsWorld.h"
+#include "GameObject.h"
+#include "SceneGraph.h"
+#include "Transform3D.h"
+#include "raymath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace
+{
+    // Up to this many colliders a packed 4-wide scan beats walking the broadphase.
+    const std::size_t kPackedScanLimit = 256;
+
+    // Spreads the low 10 bits of v to every third bit (Morton code helper).
+    uint32_t SpreadBits(uint32_t v)
+    {
+        v &= 0x3FFu;
+        v = (v | (v << 16)) & 0x030000FFu;
+        v = (v | (v <<  8)) & 0x0300F00Fu;
+        v = (v | (v <<  4)) & 0x030C30C3u;
+        v = (v | (v <<  2)) & 0x09249249u;
+        return v;
+    }
+
+    // Ray indices ordered along a Morton curve of the ray origins, so rays that
+    // start close together end up in the same packet.
+    void MortonOrder(const Ray* rays, int rayCount, std::vector<int>& order)
+    {
+        Vector3 lo = rays[0].position;
+        Vector3 hi = rays[0].position;
+        for (int i = 1; i < rayCount; ++i)
+        {
+            lo = Vector3Min(lo, rays[i].position);
+            hi = Vector3Max(hi, rays[i].position);
+        }
+
+        const Vector3 size  = Vector3Subtract(hi, lo);
+        const float   scale = 1023.0f / std::max(std::max(size.x, size.y), std::max(size.z, 1e-6f));
+
+        std::vector<std::pair<uint32_t, int>> keys(static_cast<std::size_t>(rayCount));
+        for (int i = 0; i < rayCount; ++i)
+        {
+            const Vector3 p = Vector3Scale(Vector3Subtract(rays[i].position, lo), scale);
+            keys[i] = { SpreadBits(static_cast<uint32_t>(p.x)) |
+                        (SpreadBits(static_cast<uint32_t>(p.y)) << 1) |
+                        (SpreadBits(static_cast<uint32_t>(p.z)) << 2), i };
+        }
+        std::sort(keys.begin(), keys.end());
+
+        order.resize(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            order[i] = keys[i].second;
+    }
+
+    // Face normal at the ray's entry into box (zero if the ray starts inside).
+    Vector3 EntryNormal(const Ray& ray, const BoundingBox& box)
+    {
+        const float o[3]  = { ray.position.x, ray.position.y, ray.position.z };
+        const float d[3]  = { ray.direction.x, ray.direction.y, ray.direction.z };
+        const float lo[3] = { box.min.x, box.min.y, box.min.z };
+        const float hi[3] = { box.max.x, box.max.y, box.max.z };
+
+        int   axis  = -1;
+        float entry = 0.0f;
+        for (int a = 0; a < 3; ++a)
+        {
+            if (d[a] == 0.0f)
+                continue;
+            const float t = ((d[a] > 0.0f ? lo[a] : hi[a]) - o[a]) / d[a];
+            if (t > entry)
+            {
+                entry = t;
+                axis  = a;
+            }
+        }
+
+        float n[3] = { 0.0f, 0.0f, 0.0f };
+        if (axis >= 0)
+            n[axis] = d[axis] > 0.0f ? -1.0f : 1.0f;
+        return { n[0], n[1], n[2] };
+    }
+}
+
+PhysicsWorld::PhysicsWorld(BroadphaseType type, float fatMargin)
+    : broadphase(type)
+    , tree(fatMargin)
+    , triggerTree(fatMargin)
+{
+    for (uint32_t& mask : layerMasks)
+        mask = AllLayers;
+}
+
+PhysicsWorld::~PhysicsWorld()
+{
+    // Colliders that outlive the world must not call back into it.
+    auto release = [](Collider* collider)
+    {
+        collider->physicsWorld = nullptr;
+        collider->proxyId      = AabbTree::Null;
+        collider->triggerContacts.clear();
+        collider->triggerQueued  = false;
+        collider->triggerWatched = false;
+    };
+
+    for (Collider* collider : colliders)
+        release(collider);
+    for (Collider* collider : triggerColliders)
+        release(collider);
+}
+
+void PhysicsWorld::CreateProxy(Collider* collider)
+{
+    switch (broadphase)
+    {
+    case BroadphaseType::DynamicTree:
+        collider->proxyId = tree.CreateProxy(collider->syncedBounds, collider, collider->GetLayerBit());
+        break;
+    case BroadphaseType::SpatialHash:
+        collider->proxyId = grid.CreateProxy(collider->syncedBounds, collider, collider->GetLayerBit());
+        break;
+    case BroadphaseType::BruteForce:
+        collider->proxyId = AabbTree::Null;
+        break;
+    }
+}
+
+void PhysicsWorld::DestroyProxy(Collider* collider)
+{
+    switch (broadphase)
+    {
+    case BroadphaseType::DynamicTree:
+        tree.DestroyProxy(collider->proxyId);
+        break;
+    case BroadphaseType::SpatialHash:
+        grid.DestroyProxy(collider->proxyId);
+        break;
+    case BroadphaseType::BruteForce:
+        break;
+    }
+    collider->proxyId = AabbTree::Null;
+}
+
+void PhysicsWorld::AddCollider(Collider* collider)
+{
+    if (!collider || collider->physicsWorld)
+        return;
+
+    Transform3D* transform = collider->GetGameObject()->GetTransform();
+
+    collider->physicsWorld  = this;
+    collider->syncedVersion = transform->GetWorldVersion();
+    collider->syncedBounds  = collider->GetBounds();
+    collider->shapeChanged  = false;
+    collider->OnSync();
+
+    if (collider->IsTrigger())
+    {
+        collider->kindIndex = triggerColliders.size();
+        triggerColliders.push_back(collider);
+        collider->proxyId = triggerTree.CreateProxy(collider->syncedBounds, collider, collider->GetLayerBit());
+        QueueTriggerTest(collider);
+        return;
+    }
+
+    collider->worldIndex = colliders.size();
+    colliders.push_back(collider);
+    packedBounds.Add(collider->syncedBounds, collider->GetLayerBit());
+    QueueTriggerTest(collider);
+
+    if (collider->IsStatic())
+    {
+        // Baked into the static BVH at the next sync.
+        collider->proxyId   = StaticBvh::Null;
+        collider->kindIndex = staticColliders.size();
+        staticColliders.push_back(collider);
+        staticDirty = true;
+    }
+    else
+    {
+        collider->kindIndex = dynamicColliders.size();
+        dynamicColliders.push_back(collider);
+        CreateProxy(collider);
+    }
+}
+
+void PhysicsWorld::RemoveCollider(Collider* collider)
+{
+    if (!collider || collider->physicsWorld != this)
+        return;
+
+    // Swap-remove from a collider list, keeping the moved collider's index right.
+    auto swapRemove = [](std::vector<Collider*>& list, std::size_t index, std::size_t Collider::* field)
+    {
+        list[index] = list.back();
+        list[index]->*field = index;
+        list.pop_back();
+    };
+
+    // Every pair of the collider ends with it.
+    while (!collider->triggerContacts.empty())
+    {
+        Collider* partner = collider->triggerContacts.back();
+        if (collider->IsTrigger())
+            RemoveTriggerPair(collider, partner);
+        else
+            RemoveTriggerPair(partner, collider);
+    }
+    if (collider->triggerQueued)
+    {
+        triggerTests.erase(std::find(triggerTests.begin(), triggerTests.end(), collider));
+        collider->triggerQueued = false;
+    }
+    if (collider->triggerWatched)
+    {
+        triggerWatch.erase(std::find(triggerWatch.begin(), triggerWatch.end(), collider));
+        collider->triggerWatched = false;
+    }
+
+    if (collider->IsTrigger())
+    {
+        triggerTree.DestroyProxy(collider->proxyId);
+        collider->proxyId = AabbTree::Null;
+        swapRemove(triggerColliders, collider->kindIndex, &Collider::kindIndex);
+        collider->physicsWorld = nullptr;
+        return;
+    }
+
+    if (collider->IsStatic())
+    {
+        // Hide it from the current BVH right away; rebuild at the next sync.
+        if (collider->proxyId != StaticBvh::Null)
+            staticBvh.Invalidate(collider->proxyId);
+        collider->proxyId = StaticBvh::Null;
+        swapRemove(staticColliders, collider->kindIndex, &Collider::kindIndex);
+        staticDirty = true;
+    }
+    else
+    {
+        DestroyProxy(collider);
+        swapRemove(dynamicColliders, collider->kindIndex, &Collider::kindIndex);
+    }
+
+    const std::size_t index = collider->worldIndex;
+    swapRemove(colliders, index, &Collider::worldIndex);
+    packedBounds.Remove(static_cast<int>(index));
+
+    collider->physicsWorld = nullptr;
+}
+
+void PhysicsWorld::SetBroadphaseType(BroadphaseType type)
+{
+    if (type == broadphase)
+        return;
+
+    for (Collider* collider : dynamicColliders)
+        DestroyProxy(collider);
+
+    broadphase = type;
+
+    for (Collider* collider : dynamicColliders)
+    {
+        collider->syncedBounds = collider->GetBounds();
+        collider->OnSync();
+        packedBounds.Set(static_cast<int>(collider->worldIndex), collider->syncedBounds);
+        CreateProxy(collider);
+    }
+}
+
+void PhysicsWorld::SetLayerCollision(int layerA, int layerB, bool collide)
+{
+    if (layerA < 0 || layerA >= MaxLayers || layerB < 0 || layerB >= MaxLayers)
+        return;
+
+    if (collide)
+    {
+        layerMasks[layerA] |= 1u << layerB;
+        layerMasks[layerB] |= 1u << layerA;
+    }
+    else
+    {
+        layerMasks[layerA] &= ~(1u << layerB);
+        layerMasks[layerB] &= ~(1u << layerA);
+    }
+
+    // Pairs across the two layers may start or end.
+    for (Collider* trigger : triggerColliders)
+        QueueTriggerTest(trigger);
+}
+
+void PhysicsWorld::OnLayerChanged(Collider* collider)
+{
+    const uint32_t bit = collider->GetLayerBit();
+
+    if (collider->IsTrigger())
+    {
+        triggerTree.SetProxyLayers(collider->proxyId, bit);
+        QueueTriggerTest(collider);
+        return;
+    }
+
+    packedBounds.SetLayers(static_cast<int>(collider->worldIndex), bit);
+
+    if (collider->IsStatic())
+        staticDirty = true;
+    else if (broadphase == BroadphaseType::DynamicTree)
+        tree.SetProxyLayers(collider->proxyId, bit);
+    else if (broadphase == BroadphaseType::SpatialHash)
+        grid.SetProxyLayers(collider->proxyId, bit);
+
+    QueueTriggerTest(collider);
+}
+
+void PhysicsWorld::RebuildStatic()
+{
+    std::vector<BoundingBox> boxes;
+    std::vector<void*>       owners;
+    std::vector<uint32_t>    layers;
+    boxes.reserve(staticColliders.size());
+    owners.reserve(staticColliders.size());
+    layers.reserve(staticColliders.size());
+
+    for (std::size_t i = 0; i < staticColliders.size(); ++i)
+    {
+        Collider* collider = staticColliders[i];
+        if (collider->shapeChanged)
+            QueueTriggerTest(collider);
+        collider->syncedBounds = collider->GetBounds();
+        collider->shapeChanged = false;
+        collider->proxyId      = static_cast<int>(i);   // item i of the BVH
+        collider->OnSync();
+        packedBounds.Set(static_cast<int>(collider->worldIndex), collider->syncedBounds);
+
+        boxes.push_back(collider->syncedBounds);
+        owners.push_back(collider);
+        layers.push_back(collider->GetLayerBit());
+    }
+
+    staticBvh.Build(boxes, owners, layers);
+    staticDirty = false;
+}
+
+void PhysicsWorld::SyncTransforms()
+{
+    if (staticDirty)
+        RebuildStatic();
+
+    // Static colliders never move: only dynamic ones are checked.
+    Vector3 displacement;
+    for (Collider* collider : dynamicColliders)
+    {
+        if (!SyncBounds(collider, displacement))
+            continue;
+
+        if (broadphase == BroadphaseType::DynamicTree)
+            tree.MoveProxy(collider->proxyId, collider->syncedBounds, displacement);
+        else if (broadphase == BroadphaseType::SpatialHash)
+            grid.MoveProxy(collider->proxyId, collider->syncedBounds, displacement);
+
+        packedBounds.Set(static_cast<int>(collider->worldIndex), collider->syncedBounds);
+        QueueTriggerTest(collider);
+    }
+
+    for (Collider* collider : triggerColliders)
+    {
+        if (!SyncBounds(collider, displacement))
+            continue;
+
+        triggerTree.MoveProxy(collider->proxyId, collider->syncedBounds, displacement);
+        QueueTriggerTest(collider);
+    }
+
+    UpdateTriggers();
+}
+
+bool PhysicsWorld::SyncBounds(Collider* collider, Vector3& outDisplacement)
+{
+    // Sleeping objects have not moved (any change wakes them): skip the transform.
+    if (collider->GetGameObject()->IsSleeping())
+        return false;
+
+    const uint32_t version = collider->GetGameObject()->GetTransform()->GetWorldVersion();
+    if (version == collider->syncedVersion && !collider->shapeChanged)
+        return false;
+
+    const BoundingBox bounds = collider->GetBounds();
+    outDisplacement = Vector3Subtract(bounds.min, collider->syncedBounds.min);
+
+    collider->syncedVersion = version;
+    collider->syncedBounds  = bounds;
+    collider->shapeChanged  = false;
+    collider->OnSync();
+    return true;
+}
+
+void PhysicsWorld::QueueTriggerTest(Collider* collider)
+{
+    // Without triggers there is nothing to pair with; a trigger added later
+    // finds the colliders around it with its own test.
+    if (collider->triggerQueued || (triggerColliders.empty() && collider->triggerContacts.empty()))
+        return;
+
+    collider->triggerQueued = true;
+    triggerTests.push_back(collider);
+}
+
+bool PhysicsWorld::TriggerOverlaps(const Collider* trigger, const Collider* other)
+{
+    if (trigger->GetGameObject() == other->GetGameObject() ||
+        !AabbTree::Overlaps(trigger->syncedBounds, other->syncedBounds))
+        return false;
+
+    // Shapes that do not fill their bounds test against the other's bounds.
+    if (!trigger->fillsBounds && !trigger->OverlapsShape(other->syncedBounds))
+        return false;
+    return other->fillsBounds || other->OverlapsShape(trigger->syncedBounds);
+}
+
+void PhysicsWorld::UpdateTriggers()
+{
+    // Pairs also come and go when a collider is enabled / disabled (or its
+    // object (de)activated) without moving: watch the ones that could change.
+    std::size_t kept = 0;
+    for (Collider* collider : triggerWatch)
+    {
+        if (IsQueryable(collider) != collider->triggerQueryable)
+            QueueTriggerTest(collider);
+
+        if (collider->triggerContacts.empty() && collider->triggerQueryable && !collider->triggerQueued)
+            collider->triggerWatched = false;
+        else
+            triggerWatch[kept++] = collider;
+    }
+    triggerWatch.resize(kept);
+
+    for (Collider* collider : triggerTests)
+    {
+        collider->triggerQueued = false;
+        TestTriggers(collider);
+
+        if (!collider->triggerWatched && (!collider->triggerContacts.empty() || !collider->triggerQueryable))
+        {
+            collider->triggerWatched = true;
+            triggerWatch.push_back(collider);
+        }
+    }
+    triggerTests.clear();
+}
+
+void PhysicsWorld::TestTriggers(Collider* collider)
+{
+    // Current partners of the collider...
+    std::vector<Collider*>& found = triggerScratch;
+    found.clear();
+
+    collider->triggerQueryable = IsQueryable(collider);
+    if (collider->triggerQueryable)
+    {
+        if (collider->IsTrigger())
+        {
+            QueryOverlap(collider->syncedBounds, [&](Collider* other)
+            {
+                if (TriggerOverlaps(collider, other))
+                    found.push_back(other);
+                return true;
+            }, GetLayerMask(collider->GetLayer()));
+        }
+        else
+        {
+            triggerTree.Query(collider->syncedBounds, [&](int proxy)
+            {
+                Collider* trigger = static_cast<Collider*>(triggerTree.GetUserData(proxy));
+                if (IsQueryable(trigger) && TriggerOverlaps(trigger, collider))
+                    found.push_back(trigger);
+                return true;
+            }, GetLayerMask(collider->GetLayer()));
+        }
+    }
+
+    // ...against the cached ones: only the differences become events.
+    std::sort(found.begin(), found.end());
+    std::vector<Collider*> cached = collider->triggerContacts;
+    std::sort(cached.begin(), cached.end());
+
+    std::size_t a = 0, b = 0;
+    while (a < found.size() || b < cached.size())
+    {
+        if (b == cached.size() || (a < found.size() && found[a] < cached[b]))
+        {
+            if (collider->IsTrigger()) AddTriggerPair(collider, found[a]);
+            else                       AddTriggerPair(found[a], collider);
+            ++a;
+        }
+        else if (a == found.size() || cached[b] < found[a])
+        {
+            if (collider->IsTrigger()) RemoveTriggerPair(collider, cached[b]);
+            else                       RemoveTriggerPair(cached[b], collider);
+            ++b;
+        }
+        else
+        {
+            ++a;
+            ++b;
+        }
+    }
+}
+
+void PhysicsWorld::AddTriggerPair(Collider* trigger, Collider* other)
+{
+    trigger->triggerContacts.push_back(other);
+    other->triggerContacts.push_back(trigger);
+    triggerEvents.push_back({ trigger->GetGameObject()->GetHandle(), other->GetGameObject()->GetHandle(), true });
+
+    // The partner is watched too, so disabling it ends the pair.
+    if (!other->triggerWatched)
+    {
+        other->triggerWatched = true;
+        triggerWatch.push_back(other);
+    }
+    if (!trigger->triggerWatched)
+    {
+        trigger->triggerWatched = true;
+        triggerWatch.push_back(trigger);
+    }
+}
+
+void PhysicsWorld::RemoveTriggerPair(Collider* trigger, Collider* other)
+{
+    auto unlink = [](std::vector<Collider*>& list, Collider* collider)
+    {
+        auto it = std::find(list.begin(), list.end(), collider);
+        *it = list.back();
+        list.pop_back();
+    };
+
+    unlink(trigger->triggerContacts, other);
+    unlink(other->triggerContacts, trigger);
+    triggerEvents.push_back({ trigger->GetGameObject()->GetHandle(), other->GetGameObject()->GetHandle(), false });
+}
+
+void PhysicsWorld::DispatchTriggerEvents(const SceneGraph& graph)
+{
+    // Callbacks may add, remove or move colliders: work on a private batch.
+    std::vector<TriggerEvent> events;
+    events.swap(triggerEvents);
+
+    for (const TriggerEvent& event : events)
+    {
+        GameObject* trigger = graph.Resolve(event.trigger);
+        GameObject* other   = graph.Resolve(event.other);
+
+        // An enter is only worth telling while both objects are around.
+        if (event.enter)
+        {
+            if (!trigger || !other)
+                continue;
+            trigger->TriggerEnter(other);
+            other->TriggerEnter(trigger);
+        }
+        else
+        {
+            if (trigger) trigger->TriggerExit(other);
+            if (other)   other->TriggerExit(trigger);
+        }
+    }
+}
+
+bool PhysicsWorld::IsQueryable(const Collider* collider)
+{
+    return collider->IsEnabled() && collider->GetGameObject()->IsActiveInHierarchy();
+}
+
+bool PhysicsWorld::UsePackedScan() const
+{
+    return broadphase == BroadphaseType::BruteForce || colliders.size() <= kPackedScanLimit;
+}
+
+bool PhysicsWorld::Raycast(const Ray& ray, float maxDistance, RaycastHit& outHit,
+                           const Collider* ignore, uint32_t layerMask) const
+{
+    return UsePackedScan() ? RaycastPacked(ray, maxDistance, outHit, ignore, layerMask)
+                           : RaycastBroadphase(ray, maxDistance, outHit, ignore, layerMask);
+}
+
+int PhysicsWorld::RaycastBatch(const Ray* rays, int rayCount, float maxDistance, RaycastHit* outHits,
+                               const Collider* const* ignore, const uint32_t* layerMasks) const
+{
+    int hits = 0;
+    for (int i = 0; i < rayCount; ++i)
+        outHits[i] = RaycastHit();
+
+    // Small worlds: the packed scan already tests 4 boxes per instruction for
+    // each ray, and a packet would only trade that for 4 rays per box.
+    if (UsePackedScan())
+    {
+        for (int i = 0; i < rayCount; ++i)
+        {
+            const Collider* skip = ignore ? ignore[i] : nullptr;
+            const uint32_t  mask = layerMasks ? layerMasks[i] : AllLayers;
+            if (RaycastPacked(rays[i], maxDistance, outHits[i], skip, mask))
+                ++hits;
+        }
+        return hits;
+    }
+
+    // Larger worlds: rays sorted by origin walk the trees 4 at a time, so
+    // nearby rays (agents' ground probes) share one traversal of the static
+    // BVH and the dynamic tree and every node costs one slab test per packet.
+    std::vector<int> order;
+    if (rayCount > 0)
+        MortonOrder(rays, rayCount, order);
+
+    for (int base = 0; base < rayCount; base += RayPacket::Lanes)
+    {
+        RayPacket packet;
+        int       index[RayPacket::Lanes];
+        const int lanes = rayCount - base < RayPacket::Lanes ? rayCount - base : RayPacket::Lanes;
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            index[lane] = order[base + lane];
+            packet.Set(lane, rays[index[lane]], maxDistance, layerMasks ? layerMasks[index[lane]] : AllLayers);
+        }
+
+        auto test = [&](int lane, Collider* collider, float currentMax)
+        {
+            const int i = index[lane];
+            return RaycastCandidate(rays[i], collider, ignore ? ignore[i] : nullptr, currentMax, outHits[i])
+                ? outHits[i].distance : currentMax;
+        };
+
+        staticBvh.RaycastPacket(packet, [&](int lane, int item, float currentMax)
+        {
+            return test(lane, static_cast<Collider*>(staticBvh.GetUserData(item)), currentMax);
+        });
+
+        if (broadphase == BroadphaseType::DynamicTree)
+        {
+            tree.RaycastPacket(packet, [&](int lane, int proxy, float currentMax)
+            {
+                return test(lane, static_cast<Collider*>(tree.GetUserData(proxy)), currentMax);
+            });
+        }
+        else
+        {
+            // The hash grid steps cells along each ray: no shared walk.
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const int i = index[lane];
+                grid.Raycast(rays[i], packet.maxDistance[lane], [&](int proxy, float currentMax)
+                {
+                    return test(lane, static_cast<Collider*>(grid.GetUserData(proxy)), currentMax);
+                }, packet.layerMask[lane]);
+            }
+        }
+
+        for (int lane = 0; lane < lanes; ++lane)
+        {
+            if (outHits[index[lane]].collider)
+                ++hits;
+        }
+    }
+    return hits;
+}
+
+bool PhysicsWorld::RaycastPacked(const Ray& ray, float maxDistance, RaycastHit& outHit,
+                                 const Collider* ignore, uint32_t layerMask) const
+{
+    int     best       = -1;
+    float   bestDist   = maxDistance;
+    Vector3 bestNormal = { 0.0f, 0.0f, 0.0f };
+    bool    hasNormal  = false;
+
+    // Slab entry distance is exact for boxes: only shapes that do not fill
+    // their bounds need the narrow phase.
+    packedBounds.Raycast(ray, maxDistance, [&](int index, float entry)
+    {
+        const Collider* collider = colliders[index];
+        if (collider == ignore || !IsQueryable(collider))
+            return bestDist;
+
+        if (!collider->fillsBounds)
+        {
+            float   distance;
+            Vector3 normal;
+            if (!collider->RaycastShape(ray, bestDist, distance, normal))
+                return bestDist;
+
+            best       = index;
+            bestDist   = distance;
+            bestNormal = normal;
+            hasNormal  = true;
+            return distance;
+        }
+
+        best      = index;
+        bestDist  = entry;
+        hasNormal = false;
+        return entry;
+    }, layerMask);
+
+    if (best < 0)
+        return false;
+
+    outHit.collider = colliders[best];
+    outHit.distance = bestDist;
+    outHit.point    = Vector3Add(ray.position, Vector3Scale(ray.direction, bestDist));
+    outHit.normal   = hasNormal ? bestNormal : EntryNormal(ray, packedBounds.Get(best));
+    return true;
+}
+
+bool PhysicsWorld::RaycastBroadphase(const Ray& ray, float maxDistance, RaycastHit& outHit,
+                                     const Collider* ignore, uint32_t layerMask) const
+{
+    bool found = false;
+
+    // Exact test for one candidate; returns the new search distance.
+    auto test = [&](Collider* collider, float currentMax) -> float
+    {
+        if (!RaycastCandidate(ray, collider, ignore, currentMax, outHit))
+            return currentMax;
+
+        found = true;
+        return outHit.distance;   // only closer hits from now on
+    };
+
+    staticBvh.Raycast(ray, maxDistance, [&](int item, float currentMax)
+    {
+        maxDistance = test(static_cast<Collider*>(staticBvh.GetUserData(item)), currentMax);
+        return maxDistance;
+    }, layerMask);
+
+    switch (broadphase)
+    {
+    case BroadphaseType::DynamicTree:
+        tree.Raycast(ray, maxDistance, [&](int proxy, float currentMax)
+        {
+            return test(static_cast<Collider*>(tree.GetUserData(proxy)), currentMax);
+        }, layerMask);
+        break;
+
+    case BroadphaseType::SpatialHash:
+        grid.Raycast(ray, maxDistance, [&](int proxy, float currentMax)
+        {
+            return test(static_cast<Collider*>(grid.GetUserData(proxy)), currentMax);
+        }, layerMask);
+        break;
+
+    case BroadphaseType::BruteForce:
+        for (Collider* collider : dynamicColliders)
+        {
+            if (collider->GetLayerBit() & layerMask)
+                maxDistance = test(collider, maxDistance);
+        }
+        break;
+    }
+
+    return found;
+}
+
+bool PhysicsWorld::RaycastCandidate(const Ray& ray, Collider* collider, const Collider* ignore,
+                                    float maxDistance, RaycastHit& outHit)
+{
+    if (collider == ignore || !IsQueryable(collider))
+        return false;
+
+    float   distance;
+    Vector3 normal;
+    if (!collider->RaycastShape(ray, maxDistance, distance, normal))
+        return false;
+
+    outHit.collider = collider;
+    outHit.point    = Vector3Add(ray.position, Vector3Scale(ray.direction, distance));
+    outHit.normal   = normal;
+    outHit.distance = distance;
+    return true;
+}
+
+bool PhysicsWorld::SweepBoxes(const BoundingBox& moving, Vector3 displacement,
+                              const BoundingBox& target, float& outTime, Vector3& outNormal)
+{
+    // Minkowski sum: the moving box's center travels as a ray against the
+    // target grown by the moving box's half size.
+    const float o[3]  = { (moving.min.x + moving.max.x) * 0.5f,
+                          (moving.min.y + moving.max.y) * 0.5f,
+                          (moving.min.z + moving.max.z) * 0.5f };
+    const float h[3]  = { (moving.max.x - moving.min.x) * 0.5f,
+                          (moving.max.y - moving.min.y) * 0.5f,
+                          (moving.max.z - moving.min.z) * 0.5f };
+    const float lo[3] = { target.min.x - h[0], target.min.y - h[1], target.min.z - h[2] };
+    const float hi[3] = { target.max.x + h[0], target.max.y + h[1], target.max.z + h[2] };
+    const float d[3]  = { displacement.x, displacement.y, displacement.z };
+
+    float tEnter    = -std::numeric_limits<float>::infinity();
+    float tExit     =  std::numeric_limits<float>::infinity();
+    int   enterAxis = -1;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (d[axis] == 0.0f)
+        {
+            // Not moving on this axis: must be strictly inside the slab (touching is a miss).
+            if (o[axis] <= lo[axis] || o[axis] >= hi[axis])
+                return false;
+            continue;
+        }
+
+        const float inv = 1.0f / d[axis];
+        float t1 = (lo[axis] - o[axis]) * inv;
+        float t2 = (hi[axis] - o[axis]) * inv;
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        if (t1 > tEnter)
+        {
+            tEnter    = t1;
+            enterAxis = axis;
+        }
+        tExit = std::min(tExit, t2);
+    }
+
+    // Separated, only grazing an edge, moving away, or not reached this move.
+    if (tEnter >= tExit || tExit <= 0.0f || tEnter >= 1.0f)
+        return false;
+
+    float n[3] = { 0.0f, 0.0f, 0.0f };
+
+    if (tEnter >= 0.0f && enterAxis >= 0)
+    {
+        n[enterAxis] = d[enterAxis] > 0.0f ? -1.0f : 1.0f;
+        outTime = tEnter;
+    }
+    else
+    {
+        // Already overlapping: push out along the shallowest axis, and only
+        // block motion that goes deeper along it.
+        int   axis  = 0;
+        float depth = std::numeric_limits<float>::infinity();
+        float sign  = 1.0f;
+        for (int a = 0; a < 3; ++a)
+        {
+            const float below = o[a] - lo[a];
+            const float above = hi[a] - o[a];
+            if (below < depth) { depth = below; axis = a; sign = -1.0f; }
+            if (above < depth) { depth = above; axis = a; sign =  1.0f; }
+        }
+
+        if (d[axis] * sign >= 0.0f)
+            return false;
+
+        n[axis] = sign;
+        outTime = 0.0f;
+    }
+
+    outNormal = { n[0], n[1], n[2] };
+    return true;
+}
+
+bool PhysicsWorld::SweepBox(const BoundingBox& box, Vector3 displacement, SweepHit& outHit,
+                            const Collider* ignore, uint32_t layerMask) const
+{
+    // Broadphase: everything the box could touch along the way.
+    const BoundingBox moved = { Vector3Add(box.min, displacement), Vector3Add(box.max, displacement) };
+    const BoundingBox swept = AabbTree::Union(box, moved);
+
+    bool found = false;
+    outHit.time = 1.0f;
+
+    QueryOverlap(swept, [&](Collider* collider)
+    {
+        if (collider == ignore)
+            return true;
+
+        float   time;
+        Vector3 normal;
+        float   top;
+        if (collider->SweepShape(box, displacement, time, normal, top) && time < outHit.time)
+        {
+            outHit.collider   = collider;
+            outHit.normal     = normal;
+            outHit.time       = time;
+            outHit.contactTop = top;
+            found = true;
+        }
+        return true;
+    }, layerMask);
+
+    return found;
+}
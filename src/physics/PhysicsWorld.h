@@ -0,0 +1,260 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+#include "AabbTree.h"
+#include "SpatialHashGrid.h"
+#include "PackedBounds.h"
+#include "StaticBvh.h"
+#include "Collider.h"
+#include "GameObjectHandle.h"
+
+class SceneGraph;
+
+// Result of a PhysicsWorld raycast.
+struct RaycastHit
+{
+    Collider* collider = nullptr;
+    Vector3   point    { 0.0f, 0.0f, 0.0f };
+    Vector3   normal   { 0.0f, 0.0f, 0.0f };
+    float     distance = 0.0f;
+};
+
+// Result of a PhysicsWorld box sweep.
+struct SweepHit
+{
+    Collider* collider   = nullptr;
+    Vector3   normal     { 0.0f, 0.0f, 0.0f };  // contact normal, pointing back at the moving box
+    float     time       = 1.0f;                // fraction of the displacement before contact (0..1)
+    float     contactTop = 0.0f;                // top (max y) of the part hit: the box, or a mesh triangle
+};
+
+// Acceleration structure a PhysicsWorld keeps its colliders in.
+enum class BroadphaseType
+{
+    DynamicTree,   // AabbTree: mixed sizes, mostly static scenes (default)
+    SpatialHash,   // SpatialHashGrid: many similarly sized moving colliders
+    BruteForce     // test every collider (reference / tiny scenes)
+};
+
+// PhysicsWorld:
+// - Collision scene of one SceneGraph. Colliders (BoxCollider, MeshCollider)
+//   register themselves when they start and leave when they are destroyed.
+// - Static colliders (Collider::SetStatic) are baked into an immutable BVH
+//   that is rebuilt only when statics are added, removed or resized. Dynamic
+//   colliders live in the broadphase chosen per scene (BroadphaseType). Either
+//   way queries only look at nearby colliders instead of every object.
+// - SyncTransforms() rebuilds the static BVH if needed and updates the dynamic
+//   colliders whose Transform3D changed; the owning scene calls it once per fixed
+//   step, before the components update. Queries see the world as of that
+//   sync: candidates are tested against the bounds recorded there, so queries
+//   never touch a Transform3D.
+// - Queries are const and only read the world, so worker threads may run them,
+//   also several at once (see PhysicsStage, CharacterMotorSystem), as long as
+//   nothing syncs, adds, removes or changes colliders meanwhile.
+// - Colliders on inactive objects (or disabled colliders) are skipped by queries.
+// - Trigger colliders (Collider::SetTrigger) live in a tree of their own and
+//   are invisible to queries. Their overlaps with solid colliders are kept as
+//   a persistent pair set; a sync retests only the colliders whose bounds
+//   changed (or that were enabled / disabled) and queues enter / exit events
+//   for the pairs that appeared or vanished. DispatchTriggerEvents() hands
+//   them to the components.
+// - Every collider is in one of 32 layers. A symmetric layer matrix says which
+//   layers meet (trigger pairs, and the default mask of a collider's own
+//   queries); every query takes a layer mask. Layer bits are stored next to
+//   the bounds in each broadphase, so masked-out colliders (and subtrees
+//   holding only such colliders) are skipped before any box test.
+class PhysicsWorld
+{
+public:
+    static constexpr int      MaxLayers = 32;
+    static constexpr uint32_t AllLayers = AabbTree::AllLayers;
+
+    explicit PhysicsWorld(BroadphaseType type = BroadphaseType::DynamicTree, float fatMargin = 0.1f);
+    ~PhysicsWorld();
+
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+    void AddCollider(Collider* collider);
+    void RemoveCollider(Collider* collider);
+
+    // Move every registered collider into a different broadphase.
+    void           SetBroadphaseType(BroadphaseType type);
+    BroadphaseType GetBroadphaseType() const { return broadphase; }
+
+    // Rebuild the static BVH if needed, then update every dynamic collider whose
+    // transform (or size / offset) changed since the last sync, and the trigger
+    // pairs of the colliders that moved. Colliders of sleeping objects are
+    // skipped without looking at their transform.
+    void SyncTransforms();
+
+    // Deliver the trigger events queued by the syncs since the last call
+    // (OnTriggerEnter / OnTriggerExit on both objects of each pair). graph is
+    // the scene the colliders belong to. Main thread, after SyncTransforms().
+    void DispatchTriggerEvents(const SceneGraph& graph);
+
+    // Re-bake the static BVH at the next sync (after moving a static object).
+    void MarkStaticDirty() { staticDirty = true; }
+
+    // Layer matrix (symmetric). By default every layer meets every layer.
+    void SetLayerCollision(int layerA, int layerB, bool collide);
+    bool GetLayerCollision(int layerA, int layerB) const { return (layerMasks[layerA] >> layerB) & 1u; }
+
+    // Bits of the layers that layer meets: the mask for a collider's own queries.
+    uint32_t GetLayerMask(int layer) const { return layerMasks[layer]; }
+
+    // Calls fn(Collider*) for every collider in layerMask whose bounds overlap box.
+    // fn returns false to stop early.
+    template <typename Fn>
+    void QueryOverlap(const BoundingBox& box, Fn&& fn, uint32_t layerMask = AllLayers) const;
+
+    // Closest hit along ray (direction normalized) within maxDistance, ignoring one
+    // collider and every collider outside layerMask.
+    // Small worlds (and BruteForce) scan packed collider bounds 4 at a time; these
+    // are the bounds recorded at the last SyncTransforms().
+    bool Raycast(const Ray& ray, float maxDistance, RaycastHit& outHit,
+                 const Collider* ignore = nullptr, uint32_t layerMask = AllLayers) const;
+
+    // Raycast for many rays at once (line of sight, ground probes, hit-scan).
+    // outHits[i].collider is null for rays that hit nothing; ignore and
+    // layerMasks (both optional) hold one collider to skip / one mask per ray.
+    // Returns the number of rays that hit.
+    // Above the packed-scan size, rays are sorted by origin and walked through
+    // the static BVH and the dynamic tree in packets of 4 (RayPacket), so each
+    // visited node costs one slab test for 4 rays; the hash grid is still
+    // walked per ray. Small worlds scan the packed bounds per ray, 4 boxes at a time.
+    int RaycastBatch(const Ray* rays, int rayCount, float maxDistance, RaycastHit* outHits,
+                     const Collider* const* ignore = nullptr, const uint32_t* layerMasks = nullptr) const;
+
+    // Moves box by displacement and reports the first collider in layerMask it
+    // would run into (time of impact + normal), ignoring one collider. Boxes that
+    // only touch, or that already overlap box and are being moved away from, do not count.
+    bool SweepBox(const BoundingBox& box, Vector3 displacement, SweepHit& outHit,
+                  const Collider* ignore = nullptr, uint32_t layerMask = AllLayers) const;
+
+    // Swept test of one moving box against one fixed box (same rules as SweepBox).
+    static bool SweepBoxes(const BoundingBox& moving, Vector3 displacement,
+                           const BoundingBox& target, float& outTime, Vector3& outNormal);
+
+    // Bounds of a registered collider as of the last sync (what queries test).
+    BoundingBox GetSyncedBounds(const Collider* collider) const { return collider->syncedBounds; }
+
+    // Solid colliders (triggers are counted apart).
+    std::size_t GetColliderCount() const { return colliders.size(); }
+    std::size_t GetTriggerCount() const { return triggerColliders.size(); }
+
+private:
+    BroadphaseType         broadphase;
+    AabbTree               tree;
+    SpatialHashGrid        grid;
+    std::vector<Collider*> colliders;         // every registered collider
+    std::vector<Collider*> dynamicColliders;  // in the broadphase, synced every step
+    std::vector<Collider*> staticColliders;   // baked into staticBvh
+    PackedBounds           packedBounds;      // synced bounds, same order as colliders
+    StaticBvh              staticBvh;
+    bool                   staticDirty = false;
+
+    // Trigger overlap pairs are stored on the colliders (Collider::triggerContacts).
+    struct TriggerEvent
+    {
+        GameObjectHandle trigger;
+        GameObjectHandle other;
+        bool             enter;
+    };
+
+    AabbTree                  triggerTree;
+    std::vector<Collider*>    triggerColliders;  // in triggerTree, synced every step
+    std::vector<Collider*>    triggerTests;      // bounds changed: retest their pairs
+    std::vector<Collider*>    triggerWatch;      // with pairs or disabled: checked every sync
+    std::vector<TriggerEvent> triggerEvents;     // waiting for DispatchTriggerEvents()
+    std::vector<Collider*>    triggerScratch;
+
+    uint32_t layerMasks[MaxLayers];   // row i: bits of the layers layer i meets
+
+    void RebuildStatic();
+
+    // Record a collider's current bounds if its transform or shape changed.
+    // Returns false if it did not; outDisplacement is the move since the last sync.
+    bool SyncBounds(Collider* collider, Vector3& outDisplacement);
+
+    void QueueTriggerTest(Collider* collider);
+    void UpdateTriggers();
+    void TestTriggers(Collider* collider);
+    void AddTriggerPair(Collider* trigger, Collider* other);
+    void RemoveTriggerPair(Collider* trigger, Collider* other);
+    static bool TriggerOverlaps(const Collider* trigger, const Collider* other);
+
+    // Called by Collider::SetLayer while registered.
+    friend class Collider;
+    void OnLayerChanged(Collider* collider);
+
+    static bool IsQueryable(const Collider* collider);
+
+    bool UsePackedScan() const;
+    bool RaycastPacked(const Ray& ray, float maxDistance, RaycastHit& outHit,
+                       const Collider* ignore, uint32_t layerMask) const;
+    bool RaycastBroadphase(const Ray& ray, float maxDistance, RaycastHit& outHit,
+                           const Collider* ignore, uint32_t layerMask) const;
+
+    // Exact test of one broadphase candidate: fills outHit if the ray hits it
+    // within maxDistance (the caller's current best).
+    static bool RaycastCandidate(const Ray& ray, Collider* collider, const Collider* ignore,
+                                 float maxDistance, RaycastHit& outHit);
+
+    // Broadphase proxy for one collider (none for BruteForce).
+    void CreateProxy(Collider* collider);
+    void DestroyProxy(Collider* collider);
+
+    // Shared candidate filter for every broadphase.
+    template <typename Fn>
+    static bool VisitOverlap(Collider* collider, const BoundingBox& box, Fn& fn)
+    {
+        if (!IsQueryable(collider) || !AabbTree::Overlaps(collider->syncedBounds, box))
+            return true;
+        if (!collider->fillsBounds && !collider->OverlapsShape(box))
+            return true;
+        return fn(collider);
+    }
+};
+
+template <typename Fn>
+void PhysicsWorld::QueryOverlap(const BoundingBox& box, Fn&& fn, uint32_t layerMask) const
+{
+    bool stopped = false;
+    staticBvh.Query(box, [&](int item)
+    {
+        stopped = !VisitOverlap(static_cast<Collider*>(staticBvh.GetUserData(item)), box, fn);
+        return !stopped;
+    }, layerMask);
+    if (stopped)
+        return;
+
+    switch (broadphase)
+    {
+    case BroadphaseType::DynamicTree:
+        tree.Query(box, [&](int proxy)
+        {
+            return VisitOverlap(static_cast<Collider*>(tree.GetUserData(proxy)), box, fn);
+        }, layerMask);
+        break;
+
+    case BroadphaseType::SpatialHash:
+        grid.Query(box, [&](int proxy)
+        {
+            return VisitOverlap(static_cast<Collider*>(grid.GetUserData(proxy)), box, fn);
+        }, layerMask);
+        break;
+
+    case BroadphaseType::BruteForce:
+        for (Collider* collider : dynamicColliders)
+        {
+            if ((collider->GetLayerBit() & layerMask) && !VisitOverlap(collider, box, fn))
+                break;
+        }
+        break;
+    }
+}
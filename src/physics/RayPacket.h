@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+
+#include "raylib.h"
+#include "PackedBounds.h"   // lane count and the SIMD build flag
+
+// RayPacket:
+// - Up to 4 rays stored as structure of arrays (one ray per lane), tested
+//   against one box at a time with a single SSE slab test, so a tree walk for
+//   several nearby rays visits each node once instead of once per ray.
+// - Every lane carries its own search distance and layer mask. A lane whose
+//   maxDistance is negative (unused, or done) misses every box.
+// - Axis-parallel directions use a huge finite inverse instead of inf, so no
+//   lane ever computes 0 * inf.
+struct RayPacket
+{
+    static constexpr int Lanes = PackedBounds::Lanes;
+
+    float    origin[3][Lanes];
+    float    invDir[3][Lanes];
+    float    maxDistance[Lanes];
+    uint32_t layerMask[Lanes];
+
+    RayPacket()
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+            Set(lane, Ray{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } }, -1.0f, 0u);
+    }
+
+    void Set(int lane, const Ray& ray, float distance, uint32_t mask)
+    {
+        const float position[3]  = { ray.position.x, ray.position.y, ray.position.z };
+        const float direction[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            origin[axis][lane] = position[axis];
+            invDir[axis][lane] = direction[axis] != 0.0f ? 1.0f / direction[axis] : 1e30f;
+        }
+        maxDistance[lane] = distance;
+        layerMask[lane]   = mask;
+    }
+
+    // Lanes still searching.
+    int ActiveLanes() const;
+
+    // Lane i of the result is set if ray i's layer mask meets layers.
+    int LayerLanes(uint32_t layers) const;
+
+    // Lane i of the result is set if ray i enters box within its maxDistance;
+    // writes the entry distances (0 for a ray starting inside).
+    int Enters(const BoundingBox& box, float entry[Lanes]) const;
+
+    // Enters(), reporting only the smallest entry distance of the lanes hit.
+    int EntersNearest(const BoundingBox& box, float& nearest) const
+    {
+        float entry[Lanes];
+        const int lanes = Enters(box, entry);
+
+        nearest = 0.0f;
+        bool first = true;
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            if ((lanes & (1 << lane)) && (first || entry[lane] < nearest))
+            {
+                nearest = entry[lane];
+                first   = false;
+            }
+        }
+        return lanes;
+    }
+};
+
+inline int RayPacket::ActiveLanes() const
+{
+    int lanes = 0;
+    for (int lane = 0; lane < Lanes; ++lane)
+    {
+        if (maxDistance[lane] >= 0.0f)
+            lanes |= 1 << lane;
+    }
+    return lanes;
+}
+
+inline int RayPacket::LayerLanes(uint32_t layers) const
+{
+#if PACKED_BOUNDS_SIMD
+    const __m128i bits = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(layerMask)),
+                                       _mm_set1_epi32(static_cast<int>(layers)));
+    const __m128i none = _mm_cmpeq_epi32(bits, _mm_setzero_si128());
+    return ~_mm_movemask_ps(_mm_castsi128_ps(none)) & 0xF;
+#else
+    int lanes = 0;
+    for (int lane = 0; lane < Lanes; ++lane)
+    {
+        if (layerMask[lane] & layers)
+            lanes |= 1 << lane;
+    }
+    return lanes;
+#endif
+}
+
+inline int RayPacket::Enters(const BoundingBox& box, float entry[Lanes]) const
+{
+    const float lo[3] = { box.min.x, box.min.y, box.min.z };
+    const float hi[3] = { box.max.x, box.max.y, box.max.z };
+
+#if PACKED_BOUNDS_SIMD
+    __m128 tNear = _mm_setzero_ps();
+    __m128 tFar  = _mm_loadu_ps(maxDistance);
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const __m128 o   = _mm_loadu_ps(origin[axis]);
+        const __m128 inv = _mm_loadu_ps(invDir[axis]);
+        const __m128 t1  = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(lo[axis]), o), inv);
+        const __m128 t2  = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(hi[axis]), o), inv);
+        tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+        tFar  = _mm_min_ps(tFar,  _mm_max_ps(t1, t2));
+    }
+
+    _mm_storeu_ps(entry, tNear);
+    return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+#else
+    int lanes = 0;
+    for (int lane = 0; lane < Lanes; ++lane)
+    {
+        float tNear = 0.0f;
+        float tFar  = maxDistance[lane];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float t1 = (lo[axis] - origin[axis][lane]) * invDir[axis][lane];
+            float t2 = (hi[axis] - origin[axis][lane]) * invDir[axis][lane];
+            if (t1 > t2) { const float t = t1; t1 = t2; t2 = t; }
+            if (t1 > tNear) tNear = t1;
+            if (t2 < tFar)  tFar  = t2;
+        }
+
+        entry[lane] = tNear;
+        if (tNear <= tFar)
+            lanes |= 1 << lane;
+    }
+    return lanes;
+#endif
+}
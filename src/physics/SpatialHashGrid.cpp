@@ -0,0 +1,295 @@
+#include "SpatialHashGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Boxes covering more cells than this go to the large-proxy list.
+    const int64_t kMaxCellsPerProxy = 64;
+
+    const std::size_t kMinBucketCount = 1024;
+
+    // Used until there are enough proxies to tune from.
+    const float kDefaultCellSize = 2.0f;
+
+    int32_t ToCell(float coord, float invCellSize)
+    {
+        // Clamp so far-away (or broken) coordinates cannot overflow the cast.
+        const float cell = std::floor(coord * invCellSize);
+        return static_cast<int32_t>(std::max(-1.0e9f, std::min(1.0e9f, cell)));
+    }
+
+    std::size_t NextPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+}
+
+SpatialHashGrid::SpatialHashGrid(float fixedCellSize)
+    : cellSize(fixedCellSize > 0.0f ? fixedCellSize : kDefaultCellSize)
+    , invCellSize(1.0f / cellSize)
+    , autoCellSize(fixedCellSize <= 0.0f)
+{
+    buckets.resize(kMinBucketCount);
+}
+
+// ---------------------------------------------------------------------
+// Cells
+// ---------------------------------------------------------------------
+
+SpatialHashGrid::CellRange SpatialHashGrid::ComputeCells(const BoundingBox& box) const
+{
+    CellRange range;
+    range.min[0] = ToCell(box.min.x, invCellSize);
+    range.min[1] = ToCell(box.min.y, invCellSize);
+    range.min[2] = ToCell(box.min.z, invCellSize);
+    range.max[0] = ToCell(box.max.x, invCellSize);
+    range.max[1] = ToCell(box.max.y, invCellSize);
+    range.max[2] = ToCell(box.max.z, invCellSize);
+    return range;
+}
+
+uint32_t SpatialHashGrid::BucketIndex(int32_t x, int32_t y, int32_t z) const
+{
+    const uint32_t h = (static_cast<uint32_t>(x) * 73856093u) ^
+                       (static_cast<uint32_t>(y) * 19349663u) ^
+                       (static_cast<uint32_t>(z) * 83492791u);
+    return h & static_cast<uint32_t>(buckets.size() - 1);
+}
+
+bool SpatialHashGrid::IsLarge(const CellRange& cells) const
+{
+    return cells.CellCount() > kMaxCellsPerProxy;
+}
+
+// ---------------------------------------------------------------------
+// Proxies
+// ---------------------------------------------------------------------
+
+int SpatialHashGrid::CreateProxy(const BoundingBox& box, void* userData, uint32_t layers)
+{
+    int proxy;
+    if (freeList != Null)
+    {
+        proxy    = freeList;
+        freeList = proxies[proxy].next;
+    }
+    else
+    {
+        proxy = static_cast<int>(proxies.size());
+        proxies.emplace_back();
+    }
+
+    Proxy& p   = proxies[proxy];
+    p.box      = box;
+    p.userData = userData;
+    p.layers   = layers;
+    p.next     = Null;
+    p.alive    = true;
+    Insert(proxy);
+    ++proxyCount;
+
+    // Amortized O(1): re-tune and grow the table each time the count doubles.
+    if (proxyCount >= nextRebuild)
+    {
+        nextRebuild *= 2;
+        Rebuild();
+    }
+
+    return proxy;
+}
+
+void SpatialHashGrid::DestroyProxy(int proxy)
+{
+    Remove(proxy);
+
+    Proxy& p   = proxies[proxy];
+    p.alive    = false;
+    p.userData = nullptr;
+    p.next     = freeList;
+    freeList   = proxy;
+    --proxyCount;
+}
+
+bool SpatialHashGrid::MoveProxy(int proxy, const BoundingBox& box, Vector3 /*displacement*/)
+{
+    Proxy& p = proxies[proxy];
+
+    // Same cells: only the stored box changes.
+    if (ComputeCells(box) == p.cells)
+    {
+        p.box = box;
+        if (!p.large)
+            occupied = AabbTree::Union(occupied, box);
+        return false;
+    }
+
+    Remove(proxy);
+    p.box = box;
+    Insert(proxy);
+    return true;
+}
+
+void SpatialHashGrid::Insert(int proxy)
+{
+    Proxy& p = proxies[proxy];
+    p.cells = ComputeCells(p.box);
+    p.large = IsLarge(p.cells);
+
+    if (p.large)
+    {
+        largeProxies.push_back(proxy);
+        return;
+    }
+
+    for (int32_t z = p.cells.min[2]; z <= p.cells.max[2]; ++z)
+    for (int32_t y = p.cells.min[1]; y <= p.cells.max[1]; ++y)
+    for (int32_t x = p.cells.min[0]; x <= p.cells.max[0]; ++x)
+        buckets[BucketIndex(x, y, z)].push_back(proxy);
+
+    occupied    = hasOccupied ? AabbTree::Union(occupied, p.box) : p.box;
+    hasOccupied = true;
+}
+
+void SpatialHashGrid::Remove(int proxy)
+{
+    const Proxy& p = proxies[proxy];
+
+    auto swapRemove = [proxy](std::vector<int>& list)
+    {
+        auto it = std::find(list.begin(), list.end(), proxy);
+        if (it != list.end())
+        {
+            *it = list.back();
+            list.pop_back();
+        }
+    };
+
+    if (p.large)
+    {
+        swapRemove(largeProxies);
+        return;
+    }
+
+    // One entry per covered cell (two cells may share a bucket).
+    for (int32_t z = p.cells.min[2]; z <= p.cells.max[2]; ++z)
+    for (int32_t y = p.cells.min[1]; y <= p.cells.max[1]; ++y)
+    for (int32_t x = p.cells.min[0]; x <= p.cells.max[0]; ++x)
+        swapRemove(buckets[BucketIndex(x, y, z)]);
+}
+
+void SpatialHashGrid::Rebuild()
+{
+    if (autoCellSize && proxyCount > 0)
+    {
+        // Cell = twice the median largest extent: a typical proxy covers 1-2
+        // cells per axis, and a few huge boxes cannot drag the size up.
+        std::vector<float> extents;
+        extents.reserve(proxyCount);
+        for (const Proxy& p : proxies)
+        {
+            if (!p.alive)
+                continue;
+            extents.push_back(std::max(p.box.max.x - p.box.min.x,
+                              std::max(p.box.max.y - p.box.min.y, p.box.max.z - p.box.min.z)));
+        }
+
+        auto median = extents.begin() + extents.size() / 2;
+        std::nth_element(extents.begin(), median, extents.end());
+        cellSize    = std::max(2.0f * *median, 0.01f);
+        invCellSize = 1.0f / cellSize;
+    }
+
+    buckets.assign(NextPowerOfTwo(std::max(kMinBucketCount, static_cast<std::size_t>(proxyCount) * 2)),
+                   std::vector<int>());
+    largeProxies.clear();
+    hasOccupied = false;
+
+    for (int proxy = 0; proxy < static_cast<int>(proxies.size()); ++proxy)
+    {
+        if (proxies[proxy].alive)
+            Insert(proxy);
+    }
+}
+
+// ---------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------
+
+bool SpatialHashGrid::BeginWalk(const Ray& ray, Vector3 invDir, float maxDistance, CellWalk& walk) const
+{
+    if (!hasOccupied)
+        return false;
+
+    // Clip the ray to the region that holds bucketed proxies.
+    const float o[3]   = { ray.position.x, ray.position.y, ray.position.z };
+    const float inv[3] = { invDir.x, invDir.y, invDir.z };
+    const float lo[3]  = { occupied.min.x, occupied.min.y, occupied.min.z };
+    const float hi[3]  = { occupied.max.x, occupied.max.y, occupied.max.z };
+
+    float tEnter = 0.0f;
+    float tExit  = maxDistance;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::isinf(inv[axis]))
+        {
+            if (o[axis] < lo[axis] || o[axis] > hi[axis])
+                return false;
+            continue;
+        }
+
+        float t1 = (lo[axis] - o[axis]) * inv[axis];
+        float t2 = (hi[axis] - o[axis]) * inv[axis];
+        if (t1 > t2)
+            std::swap(t1, t2);
+        tEnter = std::max(tEnter, t1);
+        tExit  = std::min(tExit, t2);
+        if (tEnter > tExit)
+            return false;
+    }
+
+    const float dir[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+    const CellRange bounds = ComputeCells(occupied);
+
+    walk.t    = tEnter;
+    walk.tEnd = tExit;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        // Clamp: the entry point may round just outside the occupied cells.
+        const int32_t cell = ToCell(o[axis] + dir[axis] * tEnter, invCellSize);
+        walk.cell[axis] = std::max(bounds.min[axis], std::min(bounds.max[axis], cell));
+
+        if (std::isinf(inv[axis]))
+        {
+            walk.step[axis]   = 0;
+            walk.tNext[axis]  = std::numeric_limits<float>::infinity();
+            walk.tDelta[axis] = std::numeric_limits<float>::infinity();
+            continue;
+        }
+
+        const bool  positive = dir[axis] > 0.0f;
+        const float boundary = (walk.cell[axis] + (positive ? 1 : 0)) * cellSize;
+        walk.step[axis]   = positive ? 1 : -1;
+        walk.tNext[axis]  = (boundary - o[axis]) * inv[axis];
+        walk.tDelta[axis] = cellSize * std::fabs(inv[axis]);
+    }
+
+    return true;
+}
+
+void SpatialHashGrid::StepWalk(CellWalk& walk)
+{
+    int axis = 0;
+    if (walk.tNext[1] < walk.tNext[axis]) axis = 1;
+    if (walk.tNext[2] < walk.tNext[axis]) axis = 2;
+
+    walk.t = walk.tNext[axis];
+    walk.cell[axis]  += walk.step[axis];
+    walk.tNext[axis] += walk.tDelta[axis];
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+#include "AabbTree.h"   // box helpers
+
+// SpatialHashGrid:
+// - Broadphase for many similarly sized, moving boxes (crowds of agents).
+// - Space is cut into uniform cubic cells; each cell hashes into a fixed-size
+//   bucket table, so there is no tree to refit. Moving a proxy only touches
+//   the buckets when it crosses into a different set of cells.
+// - The cell size is tuned from the proxies' extents (unless fixed in the
+//   constructor) whenever the proxy count doubles.
+// - Proxies that would cover too many cells (ground planes, long walls) are
+//   kept in a separate list that every query tests directly.
+// - Same proxy API, query callbacks and layer masks as AabbTree (layers are
+//   checked per proxy, before its box). A proxy sits in several
+//   buckets; queries report it only from the first of its cells they visit, so
+//   they need no scratch state and may run concurrently.
+class SpatialHashGrid
+{
+public:
+    static constexpr int Null = -1;
+
+    // cellSize <= 0: tune the cell size from the proxies.
+    explicit SpatialHashGrid(float cellSize = 0.0f);
+
+    int  CreateProxy(const BoundingBox& box, void* userData, uint32_t layers = AabbTree::AllLayers);
+    void DestroyProxy(int proxy);
+
+    void     SetProxyLayers(int proxy, uint32_t layers) { proxies[proxy].layers = layers; }
+    uint32_t GetProxyLayers(int proxy) const { return proxies[proxy].layers; }
+
+    // Returns true if the proxy moved to a different set of cells.
+    bool MoveProxy(int proxy, const BoundingBox& box, Vector3 displacement);
+
+    void*              GetUserData(int proxy) const { return proxies[proxy].userData; }
+    const BoundingBox& GetBox(int proxy) const      { return proxies[proxy].box; }
+
+    int   GetProxyCount() const { return proxyCount; }
+    float GetCellSize() const { return cellSize; }
+
+    // Calls fn(proxy) for every proxy in layerMask whose box overlaps box (each
+    // at most once). fn returns false to stop the query early.
+    template <typename Fn>
+    void Query(const BoundingBox& box, Fn&& fn, uint32_t layerMask = AabbTree::AllLayers) const;
+
+    // Calls fn(proxy, maxDistance) for every proxy in layerMask whose box the ray
+    // enters within maxDistance, walking the cells front to back. Same contract
+    // as AabbTree::Raycast.
+    template <typename Fn>
+    void Raycast(const Ray& ray, float maxDistance, Fn&& fn, uint32_t layerMask = AabbTree::AllLayers) const;
+
+private:
+    struct CellRange
+    {
+        int32_t min[3];
+        int32_t max[3];
+
+        bool operator==(const CellRange& o) const
+        {
+            return min[0] == o.min[0] && min[1] == o.min[1] && min[2] == o.min[2] &&
+                   max[0] == o.max[0] && max[1] == o.max[1] && max[2] == o.max[2];
+        }
+        bool operator!=(const CellRange& o) const { return !(*this == o); }
+
+        int64_t CellCount() const
+        {
+            return int64_t(max[0] - min[0] + 1) * (max[1] - min[1] + 1) * (max[2] - min[2] + 1);
+        }
+
+        bool Contains(const int32_t cell[3]) const
+        {
+            return cell[0] >= min[0] && cell[0] <= max[0] &&
+                   cell[1] >= min[1] && cell[1] <= max[1] &&
+                   cell[2] >= min[2] && cell[2] <= max[2];
+        }
+    };
+
+    struct Proxy
+    {
+        BoundingBox box {};
+        void*       userData = nullptr;
+        uint32_t    layers   = AabbTree::AllLayers;
+        CellRange   cells {};
+        int         next  = Null;    // free list link
+        bool        alive = false;
+        bool        large = false;   // lives in largeProxies instead of the buckets
+    };
+
+    // Walks the cells a ray passes through (3D DDA), front to back.
+    struct CellWalk
+    {
+        int32_t cell[3];
+        int32_t step[3];
+        float   tNext[3];    // ray distance to the next boundary on each axis
+        float   tDelta[3];   // ray distance between boundaries on each axis
+        float   t;           // distance at which the current cell is entered
+        float   tEnd;        // stop once t passes this
+    };
+
+    std::vector<Proxy>            proxies;
+    std::vector<std::vector<int>> buckets;        // size is a power of two
+    std::vector<int>              largeProxies;
+    BoundingBox                   occupied {};    // union of the bucketed proxies (never shrinks)
+    bool                          hasOccupied = false;
+    float                         cellSize;
+    float                         invCellSize;
+    bool                          autoCellSize;
+    int                           proxyCount = 0;
+    int                           freeList   = Null;
+    int                           nextRebuild = 16;
+
+    CellRange ComputeCells(const BoundingBox& box) const;
+    uint32_t  BucketIndex(int32_t x, int32_t y, int32_t z) const;
+    bool      IsLarge(const CellRange& cells) const;
+
+    void Insert(int proxy);
+    void Remove(int proxy);
+
+    // Re-tune the cell size / grow the bucket table and re-insert every proxy.
+    void Rebuild();
+
+    // Set up a cell walk for the ray; false if it misses the occupied region.
+    bool BeginWalk(const Ray& ray, Vector3 invDir, float maxDistance, CellWalk& walk) const;
+    static void StepWalk(CellWalk& walk);
+};
+
+template <typename Fn>
+void SpatialHashGrid::Query(const BoundingBox& box, Fn&& fn, uint32_t layerMask) const
+{
+    if (proxyCount == 0)
+        return;
+
+    for (int proxy : largeProxies)
+    {
+        const Proxy& p = proxies[proxy];
+        if ((p.layers & layerMask) && AabbTree::Overlaps(p.box, box) && !fn(proxy))
+            return;
+    }
+
+    const CellRange range = ComputeCells(box);
+
+    // A query box covering more cells than there are proxies: scan them instead.
+    if (range.CellCount() > static_cast<int64_t>(proxies.size()))
+    {
+        for (int proxy = 0; proxy < static_cast<int>(proxies.size()); ++proxy)
+        {
+            const Proxy& p = proxies[proxy];
+            if (p.alive && !p.large && (p.layers & layerMask) && AabbTree::Overlaps(p.box, box) && !fn(proxy))
+                return;
+        }
+        return;
+    }
+
+    for (int32_t z = range.min[2]; z <= range.max[2]; ++z)
+    for (int32_t y = range.min[1]; y <= range.max[1]; ++y)
+    for (int32_t x = range.min[0]; x <= range.max[0]; ++x)
+    {
+        const int32_t cell[3] = { x, y, z };
+        for (int proxy : buckets[BucketIndex(x, y, z)])
+        {
+            // Report a proxy only from the first cell the scan shares with it
+            // (this also drops proxies of other cells hashed to this bucket).
+            const CellRange& cells = proxies[proxy].cells;
+            if (!(proxies[proxy].layers & layerMask) || !cells.Contains(cell) ||
+                x != std::max(cells.min[0], range.min[0]) ||
+                y != std::max(cells.min[1], range.min[1]) ||
+                z != std::max(cells.min[2], range.min[2]))
+                continue;
+
+            if (AabbTree::Overlaps(proxies[proxy].box, box) && !fn(proxy))
+                return;
+        }
+    }
+}
+
+template <typename Fn>
+void SpatialHashGrid::Raycast(const Ray& ray, float maxDistance, Fn&& fn, uint32_t layerMask) const
+{
+    if (proxyCount == 0)
+        return;
+
+    const Vector3 invDir = {
+        1.0f / ray.direction.x,
+        1.0f / ray.direction.y,
+        1.0f / ray.direction.z
+    };
+
+    float entry;
+    for (int proxy : largeProxies)
+    {
+        if (!(proxies[proxy].layers & layerMask) ||
+            !AabbTree::RayEntersBox(ray.position, invDir, proxies[proxy].box, maxDistance, entry))
+            continue;
+        maxDistance = fn(proxy, maxDistance);
+        if (maxDistance < 0.0f)
+            return;
+    }
+
+    CellWalk walk;
+    if (!BeginWalk(ray, invDir, maxDistance, walk))
+        return;
+
+    // Each axis only ever steps one way, so the walk stays inside a proxy's
+    // cells for one unbroken run: test it when that run starts.
+    int32_t previous[3] = { 0, 0, 0 };
+    bool    hasPrevious = false;
+
+    // Any hit lies in a cell entered before it, so stop once the next cell
+    // starts beyond the closest hit so far.
+    while (walk.t <= walk.tEnd && walk.t <= maxDistance)
+    {
+        for (int proxy : buckets[BucketIndex(walk.cell[0], walk.cell[1], walk.cell[2])])
+        {
+            const CellRange& cells = proxies[proxy].cells;
+            if (!(proxies[proxy].layers & layerMask) ||
+                !cells.Contains(walk.cell) || (hasPrevious && cells.Contains(previous)))
+                continue;
+
+            if (!AabbTree::RayEntersBox(ray.position, invDir, proxies[proxy].box, maxDistance, entry))
+                continue;
+            maxDistance = fn(proxy, maxDistance);
+            if (maxDistance < 0.0f)
+                return;
+        }
+
+        previous[0] = walk.cell[0];
+        previous[1] = walk.cell[1];
+        previous[2] = walk.cell[2];
+        hasPrevious = true;
+        StepWalk(walk);
+    }
+}
@@ -0,0 +1,23 @@
+#include "StaticBvh.h"
+
+void StaticBvh::Clear()
+{
+    items.clear();
+    tree.Clear();
+}
+
+void StaticBvh::Build(const std::vector<BoundingBox>& boxes, const std::vector<void*>& userData,
+                      const std::vector<uint32_t>& layers)
+{
+    Clear();
+    if (boxes.empty())
+        return;
+
+    items.reserve(boxes.size());
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+        items.push_back({ boxes[i], userData[i], layers.empty() ? AabbTree::AllLayers : layers[i] });
+
+    tree.Build(static_cast<int>(items.size()),
+               [this](int item) { return items[item].box; },
+               [this](int item) { return items[item].layers; });
+}
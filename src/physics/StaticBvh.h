@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+#include "AabbTree.h"   // box helpers
+#include "FlatBvh.h"
+
+// StaticBvh:
+// - Bounding volume hierarchy over boxes that never move (level geometry).
+// - The hierarchy is a FlatBvh, built once; there is no insert, remove or refit.
+// - Items keep the order they were built in: item i is boxes[i] of Build().
+// - Same query callbacks and layer masks as AabbTree. Invalidate() hides an
+//   item without a rebuild (its owner went away); the owner rebuilds when convenient.
+class StaticBvh
+{
+public:
+    static constexpr int Null = -1;
+
+    // layers holds each item's layer bits (empty: every item in all layers).
+    void Build(const std::vector<BoundingBox>& boxes, const std::vector<void*>& userData,
+               const std::vector<uint32_t>& layers = std::vector<uint32_t>());
+    void Clear();
+
+    void  Invalidate(int item) { items[item].userData = nullptr; }
+    void* GetUserData(int item) const { return items[item].userData; }
+
+    int GetItemCount() const { return static_cast<int>(items.size()); }
+
+    // Calls fn(item) for every live item in layerMask whose box overlaps box.
+    // fn returns false to stop the query early.
+    template <typename Fn>
+    void Query(const BoundingBox& box, Fn&& fn, uint32_t layerMask = AabbTree::AllLayers) const;
+
+    // Calls fn(item, maxDistance) for every live item in layerMask whose box the
+    // ray enters within maxDistance, nearer subtrees first. Same contract as
+    // AabbTree::Raycast.
+    template <typename Fn>
+    void Raycast(const Ray& ray, float maxDistance, Fn&& fn, uint32_t layerMask = AabbTree::AllLayers) const;
+
+    // Raycast for up to 4 rays in one walk (see RayPacket). Calls
+    // fn(lane, item, maxDistance) for every live item in the lane's layer mask
+    // whose box that lane's ray enters within its maxDistance; fn returns the
+    // lane's new maxDistance (negative: the lane is done).
+    template <typename Fn>
+    void RaycastPacket(RayPacket& packet, Fn&& fn) const;
+
+private:
+    struct Item
+    {
+        BoundingBox box;
+        void*       userData;
+        uint32_t    layers;
+    };
+
+    std::vector<Item> items;
+    FlatBvh           tree;
+};
+
+template <typename Fn>
+void StaticBvh::Query(const BoundingBox& box, Fn&& fn, uint32_t layerMask) const
+{
+    const std::vector<int>& order = tree.GetLeafOrder();
+    tree.Query(box, layerMask, [&](int first, int count)
+    {
+        for (int i = first; i < first + count; ++i)
+        {
+            const int   item = order[i];
+            const Item& it   = items[item];
+            if (it.userData && (it.layers & layerMask) && AabbTree::Overlaps(it.box, box) && !fn(item))
+                return false;
+        }
+        return true;
+    });
+}
+
+template <typename Fn>
+void StaticBvh::Raycast(const Ray& ray, float maxDistance, Fn&& fn, uint32_t layerMask) const
+{
+    const Vector3 invDir = {
+        1.0f / ray.direction.x,
+        1.0f / ray.direction.y,
+        1.0f / ray.direction.z
+    };
+
+    const std::vector<int>& order = tree.GetLeafOrder();
+    tree.Raycast(ray, maxDistance, layerMask, [&](int first, int count, float distance)
+    {
+        float entry;
+        for (int i = first; i < first + count; ++i)
+        {
+            const int   item = order[i];
+            const Item& it   = items[item];
+            if (!it.userData || !(it.layers & layerMask) ||
+                !AabbTree::RayEntersBox(ray.position, invDir, it.box, distance, entry))
+                continue;
+
+            distance = fn(item, distance);
+            if (distance < 0.0f)
+                break;
+        }
+        return distance;
+    });
+}
+
+template <typename Fn>
+void StaticBvh::RaycastPacket(RayPacket& packet, Fn&& fn) const
+{
+    const std::vector<int>& order = tree.GetLeafOrder();
+    tree.RaycastPacket(packet, [&](int first, int count, int lanes)
+    {
+        float entry[RayPacket::Lanes];
+        for (int i = first; i < first + count; ++i)
+        {
+            const int   item = order[i];
+            const Item& it   = items[item];
+            if (!it.userData)
+                continue;
+
+            const int hits = lanes & packet.LayerLanes(it.layers) & packet.Enters(it.box, entry);
+            for (int lane = 0; lane < RayPacket::Lanes; ++lane)
+            {
+                if (hits & (1 << lane))
+                    packet.maxDistance[lane] = fn(lane, item, packet.maxDistance[lane]);
+            }
+        }
+    });
+}
@@ -0,0 +1,178 @@
+#include "TriangleBvh.h"
+#include "raymath.h"
+
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <mutex>
+
+namespace
+{
+    BoundingBox TriangleBounds(const TriangleBvh::Triangle& t)
+    {
+        return {
+            Vector3Min(Vector3Min(t.a, t.b), t.c),
+            Vector3Max(Vector3Max(t.a, t.b), t.c)
+        };
+    }
+
+    // Moller-Trumbore, both sides. Returns the ray parameter of the hit.
+    bool RayTriangle(const Ray& ray, const TriangleBvh::Triangle& t, float maxT, float& outT)
+    {
+        const float epsilon = 1e-7f;
+
+        const Vector3 edge1 = Vector3Subtract(t.b, t.a);
+        const Vector3 edge2 = Vector3Subtract(t.c, t.a);
+        const Vector3 p     = Vector3CrossProduct(ray.direction, edge2);
+        const float   det   = Vector3DotProduct(edge1, p);
+        if (std::fabs(det) < epsilon)
+            return false;
+
+        const float   invDet = 1.0f / det;
+        const Vector3 s      = Vector3Subtract(ray.position, t.a);
+        const float   u      = Vector3DotProduct(s, p) * invDet;
+        if (u < 0.0f || u > 1.0f)
+            return false;
+
+        const Vector3 q = Vector3CrossProduct(s, edge1);
+        const float   v = Vector3DotProduct(ray.direction, q) * invDet;
+        if (v < 0.0f || u + v > 1.0f)
+            return false;
+
+        const float hitT = Vector3DotProduct(edge2, q) * invDet;
+        if (hitT < 0.0f || hitT > maxT)
+            return false;
+
+        outT = hitT;
+        return true;
+    }
+
+    std::mutex                                                 cacheMutex;
+    std::map<std::string, std::weak_ptr<const TriangleBvh>>    cache;
+}
+
+std::shared_ptr<const TriangleBvh> TriangleBvh::Acquire(const Model& model, const std::string& key)
+{
+    std::string cacheKey = key;
+    if (cacheKey.empty())
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "#%p", static_cast<const void*>(model.meshes));
+        cacheKey = buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    std::weak_ptr<const TriangleBvh>& entry = cache[cacheKey];
+    if (std::shared_ptr<const TriangleBvh> existing = entry.lock())
+        return existing;
+
+    // Built under the lock: a second collider of the same asset waits for
+    // this build instead of repeating it.
+    std::shared_ptr<TriangleBvh> bvh = std::make_shared<TriangleBvh>();
+    bvh->Build(model);
+    entry = bvh;
+
+    // Drop entries whose trees are gone (their assets were unloaded).
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+        if (it->second.expired())
+            it = cache.erase(it);
+        else
+            ++it;
+    }
+
+    return bvh;
+}
+
+void TriangleBvh::Build(const Model& model)
+{
+    triangles.clear();
+    triangleBoxes.clear();
+    tree.Clear();
+    bounds = {};
+
+    std::vector<Triangle> source;
+    for (int m = 0; m < model.meshCount; ++m)
+    {
+        const Mesh& mesh = model.meshes[m];
+        if (!mesh.vertices)
+            continue;
+
+        auto vertex = [&](int i)
+        {
+            const Vector3 v = { mesh.vertices[i * 3 + 0], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2] };
+            return Vector3Transform(v, model.transform);
+        };
+
+        for (int t = 0; t < mesh.triangleCount; ++t)
+        {
+            int i0 = t * 3 + 0, i1 = t * 3 + 1, i2 = t * 3 + 2;
+            if (mesh.indices)
+            {
+                i0 = mesh.indices[i0];
+                i1 = mesh.indices[i1];
+                i2 = mesh.indices[i2];
+            }
+            if (i0 >= mesh.vertexCount || i1 >= mesh.vertexCount || i2 >= mesh.vertexCount)
+                continue;
+
+            source.push_back({ vertex(i0), vertex(i1), vertex(i2) });
+        }
+    }
+
+    if (source.empty())
+        return;
+
+    std::vector<BoundingBox> sourceBoxes;
+    sourceBoxes.reserve(source.size());
+    for (const Triangle& t : source)
+        sourceBoxes.push_back(TriangleBounds(t));
+
+    tree.Build(static_cast<int>(source.size()),
+               [&sourceBoxes](int i) { return sourceBoxes[i]; });
+
+    // Store triangles in leaf order.
+    const std::vector<int>& order = tree.GetLeafOrder();
+    triangles.reserve(order.size());
+    triangleBoxes.reserve(order.size());
+    for (int i : order)
+    {
+        triangles.push_back(source[i]);
+        triangleBoxes.push_back(sourceBoxes[i]);
+    }
+
+    bounds = tree.GetBounds();
+}
+
+bool TriangleBvh::Raycast(const Ray& ray, float maxT, float& outT, Vector3& outNormal) const
+{
+    int   best  = -1;
+    float bestT = maxT;
+    tree.Raycast(ray, maxT, AabbTree::AllLayers, [&](int first, int count, float distance)
+    {
+        for (int i = first; i < first + count; ++i)
+        {
+            float t;
+            if (RayTriangle(ray, triangles[i], distance, t))
+            {
+                best     = i;
+                bestT    = t;
+                distance = t;   // only closer hits from now on
+            }
+        }
+        return distance;
+    });
+
+    if (best < 0)
+        return false;
+
+    const Triangle& t = triangles[best];
+    Vector3 normal = Vector3Normalize(Vector3CrossProduct(Vector3Subtract(t.b, t.a), Vector3Subtract(t.c, t.a)));
+    if (Vector3DotProduct(normal, ray.direction) > 0.0f)
+        normal = Vector3Negate(normal);
+
+    outT      = bestT;
+    outNormal = normal;
+    return true;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+#include "AabbTree.h"   // box helpers
+#include "FlatBvh.h"
+
+// TriangleBvh:
+// - Bounding volume hierarchy over the triangles of a Model, in model space
+//   (model.transform already applied, the same space MeshRenderer draws).
+// - The hierarchy is a FlatBvh over the triangle bounds. Triangles are
+//   stored in its leaf order, so a leaf is one contiguous run of them.
+// - Immutable after Build(): safe to query from any thread. Acquire() shares
+//   one tree between every collider using the same asset.
+class TriangleBvh
+{
+public:
+    struct Triangle
+    {
+        Vector3 a, b, c;
+    };
+
+    // Shared tree for an asset, built on first use. key identifies the
+    // geometry (usually the model path); an empty key falls back to the
+    // model's mesh array, so assigned models are shared per Model instance.
+    static std::shared_ptr<const TriangleBvh> Acquire(const Model& model, const std::string& key);
+
+    void Build(const Model& model);
+
+    const BoundingBox& GetBounds() const { return bounds; }
+    int GetTriangleCount() const { return static_cast<int>(triangles.size()); }
+    const Triangle& GetTriangle(int index) const { return triangles[index]; }
+
+    // First triangle (either side) hit by the ray within maxT. The direction
+    // need not be normalized: outT is in units of ray.direction.
+    // outNormal is the unit face normal, facing against the ray.
+    bool Raycast(const Ray& ray, float maxT, float& outT, Vector3& outNormal) const;
+
+    // Calls fn(triangle) for every triangle whose bounds overlap box.
+    // fn returns false to stop the query early.
+    template <typename Fn>
+    void Query(const BoundingBox& box, Fn&& fn) const;
+
+private:
+    std::vector<Triangle>    triangles;       // in leaf order
+    std::vector<BoundingBox> triangleBoxes;   // same order as triangles
+    FlatBvh                  tree;
+    BoundingBox              bounds {};
+};
+
+template <typename Fn>
+void TriangleBvh::Query(const BoundingBox& box, Fn&& fn) const
+{
+    tree.Query(box, AabbTree::AllLayers, [&](int first, int count)
+    {
+        for (int i = first; i < first + count; ++i)
+        {
+            if (AabbTree::Overlaps(triangleBoxes[i], box) && !fn(triangles[i]))
+                return false;
+        }
+        return true;
+    });
+}
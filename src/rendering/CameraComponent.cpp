@@ -14,6 +14,11 @@ CameraComponent::CameraComponent()
 }
 
 void CameraComponent::Update(float /*deltaTime*/)
+{
+    SyncToTransform(1.0f);
+}
+
+void CameraComponent::SyncToTransform(float alpha)
 {
     // Build the camera state purely from the Transform3D + local offset.
     Transform3D* transform = gameObject ? gameObject->GetTransform() : nullptr;
@@ -21,7 +26,7 @@ void CameraComponent::Update(float /*deltaTime*/)
         return;
 
     // World-space basis from the Transform3D.
-    Vector3 basePos = transform->GetPosition();
+    Vector3 basePos = transform->GetInterpolatedWorldPosition(alpha);
     Vector3 forward = transform->Forward();
     Vector3 up      = transform->Up();
 
@@ -20,9 +20,20 @@ private:
 public:
     CameraComponent();
 
+    // Only reads its own Transform3D and writes its own Camera3D.
+    bool IsParallelSafe() const override { return true; }
+
+    // Follows its Transform3D only (and the renderer re-syncs it every frame).
+    bool CanSleep() const override { return true; }
+
     // Build the Camera3D from the Transform3D each frame.
     void Update(float deltaTime) override;
 
+    // Rebuild the Camera3D for rendering: position interpolated between the
+    // last two simulation steps (alpha 0..1), orientation from the current rotation
+    // so mouse look is never delayed.
+    void SyncToTransform(float alpha);
+
 
     // Call before drawing 3D geometry.
     // </summary>
@@ -36,6 +47,7 @@ public:
 
     // Set the local offset from the GameObject's origin to the eye position.
     void SetLocalOffset(const Vector3& offset) { localOffset = offset; }
+    Vector3 GetLocalOffset() const { return localOffset; }
 
     // Read-only access to the underlying Camera3D.
     const Camera3D& GetCamera() const { return camera; }
@@ -0,0 +1,122 @@
+#include "FrustumCuller.h"
+
+void FrustumCuller::SetFrustum(const Matrix& m)
+{
+    // Rows of the clip matrix (raylib matrices are applied to column vectors:
+    // row r is m[r], m[r + 4], m[r + 8], m[r + 12]). Gribb / Hartmann planes.
+    const float row0[4] = { m.m0, m.m4, m.m8,  m.m12 };
+    const float row1[4] = { m.m1, m.m5, m.m9,  m.m13 };
+    const float row2[4] = { m.m2, m.m6, m.m10, m.m14 };
+    const float row3[4] = { m.m3, m.m7, m.m11, m.m15 };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        planes[0][i] = row3[i] + row0[i];   // left
+        planes[1][i] = row3[i] - row0[i];   // right
+        planes[2][i] = row3[i] + row1[i];   // bottom
+        planes[3][i] = row3[i] - row1[i];   // top
+        planes[4][i] = row3[i] + row2[i];   // near
+        planes[5][i] = row3[i] - row2[i];   // far
+    }
+}
+
+void FrustumCuller::Clear()
+{
+    boxes.Clear();
+}
+
+void FrustumCuller::Reserve(int capacity)
+{
+    boxes.Reserve(capacity);
+    visible.reserve(static_cast<std::size_t>(capacity));
+}
+
+int FrustumCuller::Add(const BoundingBox& box)
+{
+    return boxes.Add(box);
+}
+
+int FrustumCuller::Cull()
+{
+    // The last block is padded by PackedBounds; its padding lanes are ignored.
+    const int count = boxes.Size();
+    visible.assign(static_cast<std::size_t>(count), 0);
+
+    visibleCount = 0;
+    for (int base = 0; base < count; base += Lanes)
+    {
+        const int outside = OutsideBlock(base);
+        for (int lane = 0; lane < Lanes && base + lane < count; ++lane)
+        {
+            if (!(outside & (1 << lane)))
+            {
+                visible[base + lane] = 1;
+                ++visibleCount;
+            }
+        }
+    }
+
+    testedCount = count;
+    return visibleCount;
+}
+
+#if PACKED_BOUNDS_SIMD
+
+int FrustumCuller::OutsideBlock(int base) const
+{
+    const PackedBounds::Block block = boxes.GetBlock(base);
+    const __m128 loX = _mm_loadu_ps(block.lo[0]);
+    const __m128 loY = _mm_loadu_ps(block.lo[1]);
+    const __m128 loZ = _mm_loadu_ps(block.lo[2]);
+    const __m128 hiX = _mm_loadu_ps(block.hi[0]);
+    const __m128 hiY = _mm_loadu_ps(block.hi[1]);
+    const __m128 hiZ = _mm_loadu_ps(block.hi[2]);
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 outside = zero;
+    for (const float* plane : planes)
+    {
+        // Corner furthest along the plane normal: if even that one is behind
+        // the plane, the whole box is.
+        const __m128 px = plane[0] >= 0.0f ? hiX : loX;
+        const __m128 py = plane[1] >= 0.0f ? hiY : loY;
+        const __m128 pz = plane[2] >= 0.0f ? hiZ : loZ;
+
+        __m128 distance = _mm_mul_ps(px, _mm_set1_ps(plane[0]));
+        distance = _mm_add_ps(distance, _mm_mul_ps(py, _mm_set1_ps(plane[1])));
+        distance = _mm_add_ps(distance, _mm_mul_ps(pz, _mm_set1_ps(plane[2])));
+        distance = _mm_add_ps(distance, _mm_set1_ps(plane[3]));
+
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, zero));
+        if (_mm_movemask_ps(outside) == 0xF)
+            break;
+    }
+    return _mm_movemask_ps(outside);
+}
+
+#else
+
+int FrustumCuller::OutsideBlock(int base) const
+{
+    const PackedBounds::Block block = boxes.GetBlock(base);
+
+    int outside = 0;
+    for (int lane = 0; lane < Lanes; ++lane)
+    {
+        for (const float* plane : planes)
+        {
+            const float px = (plane[0] >= 0.0f ? block.hi[0] : block.lo[0])[lane];
+            const float py = (plane[1] >= 0.0f ? block.hi[1] : block.lo[1])[lane];
+            const float pz = (plane[2] >= 0.0f ? block.hi[2] : block.lo[2])[lane];
+
+            if (plane[0] * px + plane[1] * py + plane[2] * pz + plane[3] < 0.0f)
+            {
+                outside |= 1 << lane;
+                break;
+            }
+        }
+    }
+    return outside;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+#include "PackedBounds.h"   // box storage and the SIMD build flag
+
+// FrustumCuller:
+// - Collects world-space boxes for one view (Add), then tests them all against
+//   the view frustum at once (Cull).
+// - Boxes are kept in a PackedBounds; only the plane test lives here. Each
+//   frustum plane is tested against a block of 4 boxes per SSE instruction
+//   using the box corner furthest along the plane normal (scalar loop when
+//   PACKED_BOUNDS_SIMD is 0). A block is done as soon as all 4 boxes are
+//   outside one plane.
+// - The test is conservative: a box is only culled if it lies entirely
+//   outside one of the six planes.
+class FrustumCuller
+{
+public:
+    static constexpr int Lanes = PackedBounds::Lanes;
+
+    // Frustum of the combined view * projection matrix (raylib order:
+    // MatrixMultiply(view, projection), as BeginMode3D leaves them in rlgl).
+    void SetFrustum(const Matrix& viewProjection);
+
+    void Clear();
+    void Reserve(int count);
+
+    int Add(const BoundingBox& box);   // returns the box's index
+    int Size() const { return boxes.Size(); }
+
+    // Test every box added since Clear(). Returns the number of visible boxes.
+    int Cull();
+
+    bool IsVisible(int index) const { return visible[index] != 0; }
+
+    // Boxes tested / found visible by the last Cull().
+    int GetTestedCount() const { return testedCount; }
+    int GetVisibleCount() const { return visibleCount; }
+
+private:
+    // a x + b y + c z + d >= 0 inside; left, right, bottom, top, near, far.
+    float planes[6][4] = {};
+
+    PackedBounds         boxes;
+    std::vector<uint8_t> visible;
+
+    int testedCount  = 0;
+    int visibleCount = 0;
+
+    // Lane i of the result is set if box (base + i) is outside the frustum.
+    int OutsideBlock(int base) const;
+};
@@ -0,0 +1,241 @@
+#include "InstanceBatcher.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+    // Byte offset into the bound vertex buffer, as rlSetVertexAttribute takes it.
+    const void* BufferOffset(std::size_t bytes)
+    {
+        return reinterpret_cast<const void*>(static_cast<std::uintptr_t>(bytes));
+    }
+}
+
+bool InstanceBatcher::Initialize(Shader* lightingShader, Shader* shadowShader)
+{
+    auto setup = [](PassShader& out, Shader* shader, bool withColor)
+    {
+        out.shader = shader;
+        if (!shader || shader->id == 0)
+            return false;
+
+        out.locInstanced = GetShaderLocation(*shader, "u_instanced");
+        out.locTransform = GetShaderLocationAttrib(*shader, "instanceTransform");
+        out.locColor     = withColor ? GetShaderLocationAttrib(*shader, "instanceColor") : -1;
+        return out.locInstanced >= 0 && out.locTransform >= 0 && (!withColor || out.locColor >= 0);
+    };
+
+    const bool main   = setup(shaders[static_cast<int>(Pass::Main)],   lightingShader, true);
+    const bool shadow = setup(shaders[static_cast<int>(Pass::Shadow)], shadowShader,   false);
+    enabled = main && shadow;
+
+    if (!enabled)
+        std::printf("InstanceBatcher: shaders have no instance inputs, renderers draw one by one\n");
+    return enabled;
+}
+
+void InstanceBatcher::Shutdown()
+{
+    for (InstanceBuffer& buffer : buffers)
+    {
+        if (buffer.vboId != 0)
+            rlUnloadVertexBuffer(buffer.vboId);
+        buffer = InstanceBuffer();
+    }
+    batches.clear();
+    enabled = false;
+}
+
+void InstanceBatcher::Begin(Pass newPass)
+{
+    pass = newPass;
+    for (Batch& batch : batches)
+        batch.instances.clear();
+}
+
+void InstanceBatcher::Add(int meshKey, const Mesh& mesh, unsigned int textureId, const Matrix& world, Color color)
+{
+    if (!enabled)
+        return;
+
+    // Depth only: the texture does not matter.
+    if (pass == Pass::Shadow)
+        textureId = 0;
+
+    // Renderers of one kind tend to come in runs: try the last group first.
+    auto matches = [&](const Batch& batch) { return batch.meshKey == meshKey && batch.textureId == textureId; };
+
+    if (lastBatch >= batches.size() || !matches(batches[lastBatch]))
+    {
+        lastBatch = 0;
+        while (lastBatch < batches.size() && !matches(batches[lastBatch]))
+            ++lastBatch;
+
+        if (lastBatch == batches.size())
+        {
+            batches.emplace_back();
+            batches.back().meshKey   = meshKey;
+            batches.back().textureId = textureId;
+        }
+    }
+
+    Batch& batch = batches[lastBatch];
+
+    // The first instance of the pass provides the geometry (meshes of earlier
+    // frames may have been unloaded since).
+    if (batch.instances.empty())
+        batch.mesh = mesh;
+
+    InstanceData data;
+    data.transform = world;
+    data.color[0]  = color.r;
+    data.color[1]  = color.g;
+    data.color[2]  = color.b;
+    data.color[3]  = color.a;
+    batch.instances.push_back(data);
+}
+
+void InstanceBatcher::Reserve(InstanceBuffer& buffer, int count)
+{
+    if (count <= buffer.capacity)
+        return;
+
+    if (buffer.vboId != 0)
+        rlUnloadVertexBuffer(buffer.vboId);
+
+    buffer.capacity = std::max(count, buffer.capacity * 2);
+    buffer.vboId    = rlLoadVertexBuffer(nullptr, buffer.capacity * static_cast<int>(sizeof(InstanceData)), true);
+}
+
+void InstanceBatcher::BindInstanceAttributes(const PassShader& passShader, const InstanceBuffer& buffer, int first) const
+{
+    const int         stride = static_cast<int>(sizeof(InstanceData));
+    const std::size_t base   = static_cast<std::size_t>(first) * sizeof(InstanceData);
+
+    rlEnableVertexBuffer(buffer.vboId);
+
+    // A mat4 attribute takes four consecutive locations, one per column.
+    for (int column = 0; column < 4; ++column)
+    {
+        const unsigned int location = static_cast<unsigned int>(passShader.locTransform + column);
+        rlEnableVertexAttribute(location);
+        rlSetVertexAttribute(location, 4, RL_FLOAT, false, stride, BufferOffset(base + column * sizeof(Vector4)));
+        rlSetVertexAttributeDivisor(location, 1);
+    }
+
+    if (passShader.locColor >= 0)
+    {
+        const unsigned int location = static_cast<unsigned int>(passShader.locColor);
+        rlEnableVertexAttribute(location);
+        rlSetVertexAttribute(location, 4, RL_UNSIGNED_BYTE, true, stride,
+                             BufferOffset(base + offsetof(InstanceData, color)));
+        rlSetVertexAttributeDivisor(location, 1);
+    }
+
+    rlDisableVertexBuffer();
+}
+
+void InstanceBatcher::UnbindInstanceAttributes(const PassShader& passShader) const
+{
+    for (int column = 0; column < 4; ++column)
+        rlDisableVertexAttribute(static_cast<unsigned int>(passShader.locTransform + column));
+    if (passShader.locColor >= 0)
+        rlDisableVertexAttribute(static_cast<unsigned int>(passShader.locColor));
+}
+
+void InstanceBatcher::Flush()
+{
+    drawCount     = 0;
+    instanceCount = 0;
+    if (!enabled)
+        return;
+
+    const PassShader& passShader = shaders[static_cast<int>(pass)];
+    InstanceBuffer&   buffer     = buffers[static_cast<int>(pass)];
+    const Shader&     shader     = *passShader.shader;
+
+    int total = 0;
+    for (const Batch& batch : batches)
+        total += static_cast<int>(batch.instances.size());
+    if (total == 0)
+        return;
+
+    // Every group goes into the pass buffer back to back.
+    Reserve(buffer, total);
+    int offset = 0;
+    for (const Batch& batch : batches)
+    {
+        const int count = static_cast<int>(batch.instances.size());
+        if (count == 0)
+            continue;
+        rlUpdateVertexBuffer(buffer.vboId, batch.instances.data(),
+                             count * static_cast<int>(sizeof(InstanceData)),
+                             offset * static_cast<int>(sizeof(InstanceData)));
+        offset += count;
+    }
+
+    // Instances carry their model matrix: mvp is view * projection of the pass
+    // (same accumulation as raylib's own DrawMesh).
+    const Matrix view     = MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview());
+    const Matrix viewProj = MatrixMultiply(view, rlGetMatrixProjection());
+
+    const int   on     = 1;
+    const int   off    = 0;
+    const int   slot   = 0;
+    const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    rlEnableShader(shader.id);
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], viewProj);
+    rlSetUniform(passShader.locInstanced, &on, RL_SHADER_UNIFORM_INT, 1);
+    if (shader.locs[SHADER_LOC_COLOR_DIFFUSE] >= 0)
+        rlSetUniform(shader.locs[SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+    if (shader.locs[SHADER_LOC_MAP_DIFFUSE] >= 0)
+        rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE], &slot, RL_SHADER_UNIFORM_INT, 1);
+
+    int first = 0;
+    for (const Batch& batch : batches)
+    {
+        const int count = static_cast<int>(batch.instances.size());
+        if (count == 0)
+            continue;
+
+        if (pass == Pass::Main)
+        {
+            rlActiveTextureSlot(0);
+            rlEnableTexture(batch.textureId != 0 ? batch.textureId : rlGetTextureIdDefault());
+        }
+
+        if (rlEnableVertexArray(batch.mesh.vaoId))
+        {
+            BindInstanceAttributes(passShader, buffer, first);
+
+            if (batch.mesh.indices)
+                rlDrawVertexArrayElementsInstanced(0, batch.mesh.triangleCount * 3, nullptr, count);
+            else
+                rlDrawVertexArrayInstanced(0, batch.mesh.vertexCount, count);
+
+            UnbindInstanceAttributes(passShader);
+            rlDisableVertexArray();
+
+            ++drawCount;
+            instanceCount += count;
+        }
+
+        first += count;
+    }
+
+    if (pass == Pass::Main)
+    {
+        rlActiveTextureSlot(0);
+        rlDisableTexture();
+    }
+
+    // Renderers drawn one by one use the same program afterwards.
+    rlSetUniform(passShader.locInstanced, &off, RL_SHADER_UNIFORM_INT, 1);
+    rlDisableShader();
+}
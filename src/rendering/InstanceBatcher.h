@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+
+#include "raylib.h"
+
+// InstanceBatcher:
+// - Collects draws of meshes that many objects share (the MeshRenderer
+//   primitives) during a pass and draws each group with one instanced call.
+// - Instances of a group share a mesh (and, in the main pass, a diffuse
+//   texture); each one carries its world matrix and color in a per-pass
+//   dynamic vertex buffer read by the shaders as instanceTransform / instanceColor.
+// - The lighting and shadow shaders switch to the instance attributes with
+//   the u_instanced uniform, so both passes keep a single program (and the
+//   light / shadow uniforms uploaded into it).
+// - If a shader does not expose the instance attributes, Initialize() reports
+//   it and renderers keep drawing themselves one by one.
+class InstanceBatcher
+{
+public:
+    enum class Pass { Main, Shadow };
+
+    InstanceBatcher() = default;
+    ~InstanceBatcher() = default;
+
+    InstanceBatcher(const InstanceBatcher&) = delete;
+    InstanceBatcher& operator=(const InstanceBatcher&) = delete;
+
+    // Look up the instancing inputs of both pass shaders. Returns false (and
+    // stays disabled) if either of them cannot draw instances.
+    bool Initialize(Shader* lightingShader, Shader* shadowShader);
+
+    // Free the instance buffers (GL thread).
+    void Shutdown();
+
+    bool IsEnabled() const { return enabled; }
+
+    // Start collecting the instances of one pass.
+    void Begin(Pass pass);
+
+    // Queue one instance of mesh. meshKey identifies the geometry: instances with
+    // the same key (and texture, main pass only) are drawn together with the mesh
+    // of the first one. textureId 0 means the default white texture.
+    void Add(int meshKey, const Mesh& mesh, unsigned int textureId, const Matrix& world, Color color);
+
+    // Draw everything queued since Begin(), one instanced call per group,
+    // with the current view / projection.
+    void Flush();
+
+    // Instanced calls / instances drawn by the last Flush().
+    int GetDrawCount() const { return drawCount; }
+    int GetInstanceCount() const { return instanceCount; }
+
+private:
+    // Layout of one instance in the vertex buffer (stride 68 bytes).
+    struct InstanceData
+    {
+        Matrix        transform;   // column-major, as the shaders read it
+        unsigned char color[4];    // normalized to 0..1 by the attribute
+    };
+
+    struct Batch
+    {
+        int          meshKey   = 0;
+        unsigned int textureId = 0;
+        Mesh         mesh {};
+        std::vector<InstanceData> instances;
+    };
+
+    // Inputs of one pass shader.
+    struct PassShader
+    {
+        Shader* shader       = nullptr;
+        int     locInstanced = -1;   // u_instanced
+        int     locTransform = -1;   // instanceTransform (4 consecutive locations)
+        int     locColor     = -1;   // instanceColor (lighting only)
+    };
+
+    // Growable dynamic vertex buffer of one pass.
+    struct InstanceBuffer
+    {
+        unsigned int vboId    = 0;
+        int          capacity = 0;   // in instances
+    };
+
+    PassShader     shaders[2];
+    InstanceBuffer buffers[2];
+    Pass           pass = Pass::Main;
+    bool           enabled = false;
+
+    // Groups are kept between frames so their instance arrays keep their capacity.
+    std::vector<Batch> batches;
+    std::size_t        lastBatch = 0;
+
+    int drawCount     = 0;
+    int instanceCount = 0;
+
+    // Make the pass buffer hold at least count instances.
+    void Reserve(InstanceBuffer& buffer, int count);
+
+    // Point the instance attributes of the bound vertex array at the buffer.
+    void BindInstanceAttributes(const PassShader& passShader, const InstanceBuffer& buffer, int first) const;
+    void UnbindInstanceAttributes(const PassShader& passShader) const;
+};
@@ -6,24 +6,28 @@
 LightComponent::LightComponent(Shader* lightingShader)
     : shader(lightingShader)
 {
-    if (!shader)
-        return;
+    // Uniform locations are looked up by the first Update (GL thread), so a
+    // light built on a loader worker makes no GL calls there.
+}
 
-    // Cache uniform locations – adjust names to match your GLSL.
-    locDirection = GetShaderLocation(*shader, "u_lightDir");
-    locColor     = GetShaderLocation(*shader, "u_lightColor");
-    locAmbient   = GetShaderLocation(*shader, "u_ambientColor");
+void LightComponent::MarkChanged()
+{
+    uploaded = false;
+    if (gameObject)
+        gameObject->WakeUp();
 }
 
 void LightComponent::SetUseTransformDirection(bool enabled)
 {
     useTransformDirection = enabled;
+    MarkChanged();
 }
 
 void LightComponent::SetDirection(const Vector3& dir)
 {
     // Normalize once and store.
     explicitDirection = Vector3Normalize(dir);
+    MarkChanged();
 }
 
 Vector3 LightComponent::GetDirection() const
@@ -44,21 +48,24 @@ void LightComponent::SetColor(Color color, float newIntensity)
 {
     diffuseColor = color;
     intensity    = newIntensity;
+    MarkChanged();
 }
 
 void LightComponent::SetAmbientColor(Vector3 color)
 {
     ambientColor = color;
+    MarkChanged();
 }
 
 void LightComponent::SetAmbientIntensity(float inten)
 {
     ambientIntensity = inten;
+    MarkChanged();
 }
 
 void LightComponent::Start()
 {
-    // Nothing special required for now; uniforms pushed each Update.
+    // Nothing special required for now; uniforms pushed by Update.
 }
 
 void LightComponent::Update(float /*deltaTime*/)
@@ -66,32 +73,39 @@ void LightComponent::Update(float /*deltaTime*/)
     if (!shader)
         return;
 
-    // Upload direction
-    if (locDirection >= 0)
+    // Cache uniform locations – adjust names to match your GLSL.
+    if (!locationsCached)
     {
-        Vector3 dir = GetDirection();
-        SetShaderValue(*shader, locDirection, &dir.x, SHADER_UNIFORM_VEC3);
+        locDirection    = GetShaderLocation(*shader, "u_lightDir");
+        locColor        = GetShaderLocation(*shader, "u_lightColor");
+        locAmbient      = GetShaderLocation(*shader, "u_ambientColor");
+        locationsCached = true;
     }
 
-    // Upload color * intensity
-    if (locColor >= 0)
-    {
-        // Base color 0..1
-        Vector3 colorVec = {
-            diffuseColor.r / 255.0f,
-            diffuseColor.g / 255.0f,
-            diffuseColor.b / 255.0f
-        };
+    // Base color 0..1, with the intensity scalar applied here
+    Vector3 colorVec = {
+        diffuseColor.r / 255.0f,
+        diffuseColor.g / 255.0f,
+        diffuseColor.b / 255.0f
+    };
+    colorVec = Vector3Scale(colorVec, intensity);
 
-        // Apply intensity scalar here
-        colorVec = Vector3Scale(colorVec, intensity);
+    const Vector3 dir           = GetDirection();
+    const Vector3 ambientScaled = Vector3Scale(ambientColor, ambientIntensity);
 
+    // Upload direction
+    if (locDirection >= 0 && (!uploaded || !Vector3Equals(dir, uploadedDirection)))
+        SetShaderValue(*shader, locDirection, &dir.x, SHADER_UNIFORM_VEC3);
+
+    // Upload color * intensity
+    if (locColor >= 0 && (!uploaded || !Vector3Equals(colorVec, uploadedColor)))
         SetShaderValue(*shader, locColor, &colorVec.x, SHADER_UNIFORM_VEC3);
-    }
 
-    if (locAmbient >= 0)
-    {
-        Vector3 ambientScaled = Vector3Scale(ambientColor, ambientIntensity);
+    if (locAmbient >= 0 && (!uploaded || !Vector3Equals(ambientScaled, uploadedAmbient)))
         SetShaderValue(*shader, locAmbient, &ambientScaled.x, SHADER_UNIFORM_VEC3);
-    }
+
+    uploadedDirection = dir;
+    uploadedColor     = colorVec;
+    uploadedAmbient   = ambientScaled;
+    uploaded          = true;
 }
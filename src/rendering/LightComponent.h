@@ -35,6 +35,16 @@ private:
     int locDirection = -1;
     int locColor     = -1;
     int locAmbient   = -1;
+    bool locationsCached = false;   // looked up by the first Update (GL thread)
+
+    // Values last uploaded to the shader; Update only sends what changed.
+    Vector3 uploadedDirection {};
+    Vector3 uploadedColor {};
+    Vector3 uploadedAmbient {};
+    bool    uploaded = false;
+
+    // A setter changed the light: wake the owner so the next Update uploads it.
+    void MarkChanged();
 
 public:
     /// <summary>
@@ -47,6 +57,7 @@ public:
     /// When enabled, editor / scripts just rotate the Transform.
     /// </summary>
     void SetUseTransformDirection(bool enabled);
+    bool UsesTransformDirection() const { return useTransformDirection; }
 
     /// <summary>
     /// Sets an explicit world-space direction (normalized internally).
@@ -65,14 +76,18 @@ public:
     /// Sets the light diffuse color (0..255) and intensity multiplier.
     /// </summary>
     void SetColor(Color color, float newIntensity);
+    Color GetColor() const { return diffuseColor; }
+    float GetIntensity() const { return intensity; }
 
     /// <summary>
     /// Sets the ambient color contribution (0..1).
     /// </summary>
     void SetAmbientColor(Vector3 color);
+    Vector3 GetAmbientColor() const { return ambientColor; }
 
     // Sets the ambient intensity multiplier (1.0 = normal).
     void SetAmbientIntensity(float intensity);
+    float GetAmbientIntensity() const { return ambientIntensity; }
 
     /// <summary>
     /// Called once when the component is added / scene started.
@@ -80,7 +95,10 @@ public:
     void Start() override;
 
     /// <summary>
-    /// Each frame, uploads light uniforms into the shader.
+    /// Uploads the light uniforms that changed since the last upload.
     /// </summary>
     void Update(float deltaTime) override;
+
+    // Only reacts to its own settings and Transform3D, which wake it.
+    bool CanSleep() const override { return true; }
 };
@@ -1,4 +1,5 @@
 #include "MeshFilter.h"
+#include "MainThreadQueue.h"
 
 MeshFilter::MeshFilter(const char* modelPath)
 {
@@ -7,50 +8,51 @@ MeshFilter::MeshFilter(const char* modelPath)
 
 MeshFilter::~MeshFilter()
 {
-    if (hasModel && ownsModel)
-    {
-        UnloadModel(model);
-        hasModel  = false;
-        ownsModel = false;
-    }
+    ReleaseModel();
 }
 
-void MeshFilter::LoadModelFromFile(const char* modelPath)
+void MeshFilter::ReleaseModel()
 {
-    // Unload previous model if we own it
     if (hasModel && ownsModel)
     {
-        UnloadModel(model);
+        // GPU release: on the GL thread (filters may be built and dropped on a worker).
+        Model owned = model;
+        MainThreadQueue::RunOrQueue([owned]() { UnloadModel(owned); });
     }
 
-    model = LoadModel(modelPath);
-    hasModel  = true;
-    ownsModel = true;
+    hasModel  = false;
+    ownsModel = false;
+    sharedModel.reset();
+}
+
+void MeshFilter::LoadModelFromFile(const char* modelPath)
+{
+    ReleaseModel();
+    sourcePath  = modelPath;
+    sharedModel = ModelCache::AcquireFile(sourcePath);
 }
 
 void MeshFilter::SetModel(Model m, bool takeOwnership)
 {
-    if (hasModel && ownsModel)
-    {
-        UnloadModel(model);
-    }
+    ReleaseModel();
 
     model     = m;
     hasModel  = true;
     ownsModel = takeOwnership;
+    sourcePath.clear();
 }
 
 bool MeshFilter::HasModel() const
 {
-    return hasModel;
+    return sharedModel ? sharedModel->loaded : hasModel;
 }
 
 Model& MeshFilter::GetModel()
 {
-    return model;
+    return sharedModel ? sharedModel->model : model;
 }
 
 const Model& MeshFilter::GetModel() const
 {
-    return model;
+    return sharedModel ? sharedModel->model : model;
 }
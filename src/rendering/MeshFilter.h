@@ -1,19 +1,34 @@
 #pragma once
 
+#include <string>
+
 #include "raylib.h"
 #include "Component.h"
+#include "ModelCache.h"
 
 /// <summary>
 /// MeshFilter is responsible for holding a Model (geometry) for a GameObject.
 /// MeshRenderer in CUSTOM mode will query MeshFilter on the same GameObject
 /// to obtain the Model to draw.
+/// Models loaded from files are shared through ModelCache: every filter
+/// referencing the same path uses one loaded Model.
 /// </summary>
 class MeshFilter : public Component {
 private:
+    // Shared model loaded from sourcePath (see ModelCache).
+    ModelCache::Handle sharedModel;
+
+    // Model assigned with SetModel.
     Model model{};
     bool  hasModel = false;
     bool  ownsModel = false;
 
+    // Drop the assigned model (unloading it if owned) and the shared one.
+    void ReleaseModel();
+
+    // File the model was loaded from (empty if assigned with SetModel).
+    std::string sourcePath;
+
 public:
     /// <summary>
     /// Default constructor: initially has no model.
@@ -26,13 +41,15 @@ public:
     explicit MeshFilter(const char* modelPath);
 
     /// <summary>
-    /// Destructor: releases the Model if owned.
+    /// Destructor: releases the Model if owned (shared ones when no filter uses them anymore).
     /// </summary>
     ~MeshFilter();
 
     /// <summary>
-    /// Loads a Model from file and takes ownership of it.
+    /// Uses the Model loaded from file, loading it unless another filter already did.
     /// If a previous owned model exists, unloads it first.
+    /// Off the GL thread OBJ files are parsed right here and only their uploads
+    /// are queued on MainThreadQueue (see ModelCache::AcquireFile).
     /// </summary>
     void LoadModelFromFile(const char* modelPath);
 
@@ -47,6 +64,11 @@ public:
     /// </summary>
     bool HasModel() const;
 
+    /// <summary>
+    /// Path passed to LoadModelFromFile, or an empty string for assigned models.
+    /// </summary>
+    const std::string& GetModelPath() const { return sourcePath; }
+
     /// <summary>
     /// Returns a reference to the underlying Model. Caller must ensure HasModel() is true.
     /// </summary>
@@ -2,49 +2,49 @@
 #include "GameObject.h"
 #include "Transform3D.h"
 #include "MeshFilter.h"
+#include "RenderQueue.h"
+#include "MainThreadQueue.h"
 #include "raymath.h"
 #include "rlgl.h"
+#include <cmath>
 #include <cstdio>
 
 Shader* MeshRenderer::sLightingShader = nullptr;
 Shader* MeshRenderer::sShadowShader   = nullptr;
+RenderQueue* MeshRenderer::sRenderQueue = nullptr;
+float   MeshRenderer::sInterpolationAlpha = 1.0f;
+MeshRenderer::ShadowCasters MeshRenderer::sShadowCasters = MeshRenderer::ShadowCasters::All;
 
 MeshRenderer::MeshRenderer(MeshType type, Color col)
     : meshType(type)
     , color(col)
 {
-    if (meshType == CUSTOM)
-    {
-        hasModel  = false;
-        ownsModel = false;
-        return;
-    }
-
-    Mesh mesh{};
+    // Shared per shape; the cache defers the upload when built off the GL thread.
     switch (meshType)
     {
-        case CUBE:   mesh = GenMeshCube(1.0f, 1.0f, 1.0f); break;
-        case SPHERE: mesh = GenMeshSphere(0.5f, 16, 16);   break;
-        case PLANE:  mesh = GenMeshPlane(1.0f, 1.0f, 1, 1);break;
+        case CUBE:   primitive = ModelCache::AcquireCube(1.0f, 1.0f, 1.0f); break;
+        case SPHERE: primitive = ModelCache::AcquireSphere(0.5f, 16, 16);   break;
+        case PLANE:  primitive = ModelCache::AcquirePlane(1.0f, 1.0f, 1, 1);break;
         case CUSTOM: default: break;
     }
-
-    if (mesh.vertexCount > 0)
-    {
-        model    = LoadModelFromMesh(mesh);
-        hasModel = true;
-        ownsModel = true;
-    }
 }
 
 MeshRenderer::~MeshRenderer()
+{
+    ReleaseModel();
+}
+
+void MeshRenderer::ReleaseModel()
 {
     if (hasModel && ownsModel)
     {
-        UnloadModel(model);
-        hasModel  = false;
-        ownsModel = false;
+        // GPU release: on the GL thread (renderers may be built and dropped on a worker).
+        Model owned = model;
+        MainThreadQueue::RunOrQueue([owned]() { UnloadModel(owned); });
     }
+
+    hasModel  = false;
+    ownsModel = false;
 }
 
 void MeshRenderer::SetColor(Color col)
@@ -60,13 +60,13 @@ void MeshRenderer::SetDiffuseTexture(Texture2D tex)
 
 void MeshRenderer::SetModel(Model m, bool takeOwnership)
 {
-    if (hasModel && ownsModel)
-        UnloadModel(model);
+    ReleaseModel();
 
     model     = m;
     hasModel  = true;
     ownsModel = takeOwnership;
     meshType  = CUSTOM;
+    primitive.reset();
 }
 
 void MeshRenderer::SetGlobalShader(Shader* shader)
@@ -79,39 +79,168 @@ void MeshRenderer::SetShadowShader(Shader* shader)
     sShadowShader = shader;
 }
 
-void MeshRenderer::Draw()
+void MeshRenderer::SetRenderQueue(RenderQueue* queue)
 {
-    // Decide which model to draw
-    Model* drawModel = nullptr;
+    sRenderQueue = queue;
+}
 
-    if (meshType == CUSTOM)
+void MeshRenderer::EmitPackets(const Model& drawModel, const Matrix& world) const
+{
+    const Matrix matModel = MatrixMultiply(drawModel.transform, world);
+    for (int i = 0; i < drawModel.meshCount; i++)
     {
-        MeshFilter* filter = gameObject->GetComponent<MeshFilter>();
-        if (filter && filter->HasModel())
-        {
-            drawModel = &filter->GetModel();
-        }
-        else if (hasModel)
+        const int materialIndex = drawModel.meshMaterial[i];
+
+        DrawPacket packet;
+        packet.mesh      = &drawModel.meshes[i];
+        packet.material  = &drawModel.materials[materialIndex];
+        packet.transform = matModel;
+
+        // Color and texture apply to the first material, as in the immediate path.
+        if (materialIndex == 0)
         {
-            drawModel = &model;
+            packet.color     = color;
+            packet.textureId = hasTexture ? diffuse.id : 0;
         }
         else
         {
-            return;
+            packet.color = packet.material->maps[MATERIAL_MAP_DIFFUSE].color;
         }
+
+        // Every primitive of a type shares one cached model: the type is the group key.
+        if (meshType != CUSTOM)
+            packet.instanceKey = static_cast<int>(meshType);
+
+        sRenderQueue->Add(packet);
     }
-    else
+}
+
+const Model* MeshRenderer::GetDrawModel() const
+{
+    if (meshType != CUSTOM)
+        return primitive && primitive->loaded ? &primitive->model : nullptr;
+
+    MeshFilter* filter = gameObject->GetComponent<MeshFilter>();
+    if (filter && filter->HasModel())
+        return &filter->GetModel();
+    return hasModel ? &model : nullptr;
+}
+
+Model* MeshRenderer::GetDrawModel()
+{
+    return const_cast<Model*>(static_cast<const MeshRenderer*>(this)->GetDrawModel());
+}
+
+void MeshRenderer::DrawWithWorldMatrix(const Model& drawModel, const Matrix& world)
+{
+    // Same as DrawModelEx, but with a full world matrix instead of pos/axis-angle/scale.
+    Matrix matModel = MatrixMultiply(drawModel.transform, world);
+    for (int i = 0; i < drawModel.meshCount; i++)
     {
-        if (!hasModel) return;
-        drawModel = &model;
+        DrawMesh(drawModel.meshes[i], drawModel.materials[drawModel.meshMaterial[i]], matModel);
     }
+}
+
+void MeshRenderer::SetInterpolationAlpha(float alpha)
+{
+    sInterpolationAlpha = alpha;
+}
+
+void MeshRenderer::SetShadowCasters(ShadowCasters casters)
+{
+    sShadowCasters = casters;
+}
+
+uint64_t MeshRenderer::GetShadowCasterHash() const
+{
+    const Model* drawModel = GetDrawModel();
+
+    Transform3D* t = gameObject->GetTransform();
+    if (!t || !drawModel) return 0;
+
+    const MeshRenderer* self   = this;
+    const Mesh*         meshes = drawModel->meshes;
+    const Matrix&       world  = t->GetWorldMatrix();
+
+    // FNV-1a over the renderer, its geometry and where it stands.
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const void* data, std::size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+    };
+    mix(&self, sizeof(self));
+    mix(&meshes, sizeof(meshes));
+    mix(&world, sizeof(world));
+    return hash;
+}
+
+bool MeshRenderer::GetWorldBounds(BoundingBox& out)
+{
+    Model* drawModel = GetDrawModel();
+
+    Transform3D* t = gameObject->GetTransform();
+    if (!t || !drawModel || drawModel->meshCount == 0) return false;
+
+    // Mesh-space bounds: the cached primitives are unit shapes around the origin.
+    BoundingBox local;
+    switch (meshType)
+    {
+        case CUBE:
+        case SPHERE: local = { { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } }; break;
+        case PLANE:  local = { { -0.5f,  0.0f, -0.5f }, { 0.5f, 0.0f, 0.5f } }; break;
+        case CUSTOM:
+        default:
+            if (localBoundsSource != drawModel->meshes)
+            {
+                localBounds = GetMeshBoundingBox(drawModel->meshes[0]);
+                for (int i = 1; i < drawModel->meshCount; i++)
+                {
+                    const BoundingBox mesh = GetMeshBoundingBox(drawModel->meshes[i]);
+                    localBounds.min = Vector3Min(localBounds.min, mesh.min);
+                    localBounds.max = Vector3Max(localBounds.max, mesh.max);
+                }
+                localBoundsSource = drawModel->meshes;
+            }
+            local = localBounds;
+            break;
+    }
+
+    // Transform center and extents (extents through the absolute 3x3), which
+    // keeps the box tight under rotation without transforming eight corners.
+    const Matrix m = MatrixMultiply(drawModel->transform, t->GetInterpolatedWorldMatrix(sInterpolationAlpha));
+
+    const Vector3 center  = Vector3Transform(Vector3Scale(Vector3Add(local.min, local.max), 0.5f), m);
+    const Vector3 extents = Vector3Scale(Vector3Subtract(local.max, local.min), 0.5f);
+    const Vector3 size =
+    {
+        std::fabs(m.m0) * extents.x + std::fabs(m.m4) * extents.y + std::fabs(m.m8)  * extents.z,
+        std::fabs(m.m1) * extents.x + std::fabs(m.m5) * extents.y + std::fabs(m.m9)  * extents.z,
+        std::fabs(m.m2) * extents.x + std::fabs(m.m6) * extents.y + std::fabs(m.m10) * extents.z
+    };
+
+    out.min = Vector3Subtract(center, size);
+    out.max = Vector3Add(center, size);
+    return true;
+}
+
+void MeshRenderer::Draw()
+{
+    if (culled) return;
+
+    // Decide which model to draw
+    Model* drawModel = GetDrawModel();
 
     Transform3D* t = gameObject->GetTransform();
     if (!t || !drawModel) return;
 
-    Vector3 pos   = t->GetPosition();
-    Vector3 rot   = t->GetRotation();
-    Vector3 scale = t->GetScale();
+    const Matrix world = t->GetInterpolatedWorldMatrix(sInterpolationAlpha);
+    if (sRenderQueue)
+    {
+        EmitPackets(*drawModel, world);
+        return;
+    }
 
     // Hook up lighting shader
     if (sLightingShader)
@@ -121,12 +250,16 @@ void MeshRenderer::Draw()
     if (hasTexture)
         drawModel->materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = diffuse;
 
-    DrawModelEx(*drawModel, pos, { 0, 1, 0 }, rot.y, scale, WHITE);
+    DrawWithWorldMatrix(*drawModel, world);
 }
 
 void MeshRenderer::DrawShadow()
 {
     static int drawCount = 0;
+
+    if ((sShadowCasters == ShadowCasters::Static  && !staticShadow) ||
+        (sShadowCasters == ShadowCasters::Dynamic &&  staticShadow))
+        return;
     
     if (!sShadowShader)
     {
@@ -134,50 +267,32 @@ void MeshRenderer::DrawShadow()
         return;
     }
 
-    Model* drawModel = nullptr;
-
-    if (meshType == CUSTOM)
-    {
-        MeshFilter* filter = gameObject->GetComponent<MeshFilter>();
-        if (filter && filter->HasModel())
-        {
-            drawModel = &filter->GetModel();
-        }
-        else if (hasModel)
-        {
-            drawModel = &model;
-        }
-        else
-        {
-            return;
-        }
-    }
-    else
-    {
-        if (!hasModel) return;
-        drawModel = &model;
-    }
+    Model* drawModel = GetDrawModel();
 
     Transform3D* t = gameObject->GetTransform();
     if (!t || !drawModel) return;
 
-    Vector3 pos   = t->GetPosition();
-    Vector3 rot   = t->GetRotation();
-    Vector3 scale = t->GetScale();
-
     if (drawCount < 1)
     {
+        Vector3 pos = t->GetWorldPosition();
         printf("DrawShadow called: pos=(%.1f,%.1f,%.1f), shader.id=%d\n", 
                pos.x, pos.y, pos.z, sShadowShader->id);
         drawCount++;
     }
 
+    const Matrix world = t->GetInterpolatedWorldMatrix(sInterpolationAlpha);
+    if (sRenderQueue)
+    {
+        EmitPackets(*drawModel, world);
+        return;
+    }
+
     // Temporarily override the model's shader
     Shader oldShader = drawModel->materials[0].shader;
     drawModel->materials[0].shader = *sShadowShader;
     
-    // Draw using raylib's normal function
-    DrawModelEx(*drawModel, pos, { 0, 1, 0 }, rot.y, scale, WHITE);
+    // Draw with the interpolated world matrix (includes parent transforms)
+    DrawWithWorldMatrix(*drawModel, world);
     
     // Restore original shader
     drawModel->materials[0].shader = oldShader;
@@ -1,46 +1,118 @@
 #pragma once
 
+#include <cstdint>
+
 #include "raylib.h"
 #include "Component.h"
+#include "ModelCache.h"
 
 class MeshFilter;
+class RenderQueue;
 
 /// <summary>
 /// Renders a 3D model for a GameObject.
 /// Supports simple built-in primitives (cube, sphere, plane) or CUSTOM
 /// geometry provided by a MeshFilter on the same GameObject.
 /// Also participates in the shadow pass.
+/// Primitive geometry comes from ModelCache: every cube (sphere, plane)
+/// shares one uploaded model.
+/// With a render queue set, Draw() / DrawShadow() only emit draw packets into
+/// the pipeline's RenderQueue, which sorts them by state and draws them (and
+/// batches primitives into instanced groups); otherwise they draw immediately.
+/// Static shadow casters are drawn into the shadow map's cached static layer
+/// and skipped by the per-frame shadow pass (see ShadowMap).
+/// The render pipeline frustum-culls renderers from their world bounds
+/// before the main pass; culled ones skip Draw() (shadows still cast).
 /// </summary>
 class MeshRenderer : public Component
 {
 public:
     enum MeshType { CUBE, SPHERE, PLANE, CUSTOM };
 
+    // Casters drawn by DrawShadow(), chosen by the pipeline per shadow pass.
+    enum class ShadowCasters { All, Static, Dynamic };
+
 private:
     MeshType meshType = CUBE;
 
-    Model model{};      // internal model for primitives
+    ModelCache::Handle primitive;   // shared primitive model (not CUSTOM)
+
+    Model model{};      // model assigned with SetModel
     bool  hasModel  = false;
     bool  ownsModel = false;
 
+    // Drop the assigned model, unloading it (on the GL thread) if owned.
+    void ReleaseModel();
+
     Color    color      = WHITE;
     Texture2D diffuse   = { 0 };
     bool     hasTexture = false;
 
+    // Mesh-space bounds of the drawn model (CUSTOM only; primitives are fixed),
+    // cached for the model's mesh array.
+    BoundingBox localBounds{};
+    const Mesh* localBoundsSource = nullptr;
+
+    bool culled = false;   // outside the camera frustum this frame
+
+    bool staticShadow = false;   // caster of the cached static shadow layer
+
     // Global shader pointers for all MeshRenderer instances
     static Shader* sLightingShader;
     static Shader* sShadowShader;
 
+    // Queue of the pass being drawn (owned by the render pipeline; may be null)
+    static RenderQueue* sRenderQueue;
+
+    // Render interpolation factor between the last two simulation steps
+    static float sInterpolationAlpha;
+
+    static ShadowCasters sShadowCasters;
+
+    // Model to draw this frame (primitive, MeshFilter's or assigned), or nullptr.
+    Model* GetDrawModel();
+    const Model* GetDrawModel() const;
+
+    // Draw every mesh of the model with the given world matrix.
+    static void DrawWithWorldMatrix(const Model& drawModel, const Matrix& world);
+
+    // One draw packet per mesh of the model into the render queue.
+    void EmitPackets(const Model& drawModel, const Matrix& world) const;
+
 public:
     MeshRenderer(MeshType type = CUBE, Color col = WHITE);
     ~MeshRenderer();
 
+    MeshType GetMeshType() const { return meshType; }
+    Color    GetColor() const { return color; }
+
     void SetColor(Color col);
     void SetDiffuseTexture(Texture2D tex);
     void SetModel(Model m, bool takeOwnership = true);
 
     static void SetGlobalShader(Shader* shader);
     static void SetShadowShader(Shader* shader);
+    static void SetRenderQueue(RenderQueue* queue);
+    static void SetInterpolationAlpha(float alpha);
+
+    // World-space box around the model at this frame's interpolated pose.
+    // False if there is nothing to draw yet.
+    bool GetWorldBounds(BoundingBox& out);
+
+    // Set by the render pipeline's frustum culling; skips the main pass only.
+    void SetCulled(bool value) { culled = value; }
+    bool IsCulled() const { return culled; }
+
+    // Static casters must not move: they are drawn once into the shadow map's
+    // static layer, which is only redrawn when the light or a static caster changes.
+    void SetStaticShadowCaster(bool value) { staticShadow = value; }
+    bool IsStaticShadowCaster() const { return staticShadow; }
+
+    static void SetShadowCasters(ShadowCasters casters);
+
+    // Hash of what this renderer puts into the static layer (model and world
+    // matrix), 0 while it has nothing to draw.
+    uint64_t GetShadowCasterHash() const;
 
     void Draw() override;
     void DrawShadow() override;
@@ -0,0 +1,187 @@
+#include "ModelCache.h"
+#include "MainThreadQueue.h"
+#include "ObjLoader.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace
+{
+    std::mutex                                         cacheMutex;
+    std::map<std::string, std::weak_ptr<SharedModel>>  cache;
+
+    // Last handle gone: unload on the GL thread, then free the entry.
+    void ReleaseModel(SharedModel* entry)
+    {
+        MainThreadQueue::RunOrQueue([entry]()
+        {
+            if (entry->loaded)
+                UnloadModel(entry->model);
+            delete entry;
+        });
+    }
+
+    // Case-insensitive extension test (raylib's IsFileExtension is not thread-safe).
+    bool HasExtension(const std::string& path, const char* extension)
+    {
+        const std::size_t length = std::strlen(extension);
+        if (path.size() < length)
+            return false;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            const char c = path[path.size() - length + i];
+            if (std::tolower(static_cast<unsigned char>(c)) != extension[i])
+                return false;
+        }
+        return true;
+    }
+
+    // Key text (snprintf: TextFormat's buffers are not thread-safe).
+    template <typename... Args>
+    std::string MakeKey(const char* format, Args... args)
+    {
+        char buffer[96];
+        std::snprintf(buffer, sizeof(buffer), format, args...);
+        return buffer;
+    }
+}
+
+ModelCache::Handle ModelCache::AcquireCube(float width, float height, float length)
+{
+    return Acquire(MakeKey("cube:%g:%g:%g", width, height, length), [=]()
+    {
+        return LoadModelFromMesh(GenMeshCube(width, height, length));
+    });
+}
+
+ModelCache::Handle ModelCache::AcquireSphere(float radius, int rings, int slices)
+{
+    return Acquire(MakeKey("sphere:%g:%d:%d", radius, rings, slices), [=]()
+    {
+        return LoadModelFromMesh(GenMeshSphere(radius, rings, slices));
+    });
+}
+
+ModelCache::Handle ModelCache::AcquirePlane(float width, float length, int resX, int resZ)
+{
+    return Acquire(MakeKey("plane:%g:%g:%d:%d", width, length, resX, resZ), [=]()
+    {
+        return LoadModelFromMesh(GenMeshPlane(width, length, resX, resZ));
+    });
+}
+
+ModelCache::Handle ModelCache::AcquireFile(const std::string& path)
+{
+    // "file:" keeps paths apart from the primitive keys.
+    bool  created = false;
+    Handle model  = Insert("file:" + path, created);
+    if (!created)
+        return model;
+
+    // OBJ: parsed (and its textures decoded) right here, on the loader worker
+    // during async loads; the GL thread only gets one small task per mesh and
+    // per material, so PumpLoading can spread a big model over frames.
+    auto data = std::make_shared<ObjModelData>();
+    if (!HasExtension(path, ".obj") || !ObjLoader::Load(path, *data))
+    {
+        // Other formats: raylib parses and uploads them in one LoadModel call.
+        MainThreadQueue::RunOrQueue([model, path]()
+        {
+            model->model  = LoadModel(path.c_str());
+            model->loaded = true;
+        });
+        return model;
+    }
+
+    for (int i = 0; i < data->model.meshCount; ++i)
+    {
+        MainThreadQueue::RunOrQueue([model, data, i]()
+        {
+            UploadMesh(&data->model.meshes[i], false);
+        });
+    }
+
+    for (int i = 0; i < data->model.materialCount; ++i)
+    {
+        MainThreadQueue::RunOrQueue([model, data, i]()
+        {
+            Material& material = data->model.materials[i];
+            material = LoadMaterialDefault();
+            material.maps[MATERIAL_MAP_DIFFUSE].color = data->diffuseColors[i];
+
+            Image& map = data->diffuseMaps[i];
+            if (map.data)
+            {
+                material.maps[MATERIAL_MAP_DIFFUSE].texture = LoadTextureFromImage(map);
+                UnloadImage(map);
+                map = Image{};
+            }
+        });
+    }
+
+    MainThreadQueue::RunOrQueue([model, data]()
+    {
+        model->model  = data->model;
+        model->loaded = true;
+    });
+    return model;
+}
+
+std::size_t ModelCache::GetLiveCount()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    std::size_t count = 0;
+    for (const auto& entry : cache)
+    {
+        if (!entry.second.expired())
+            ++count;
+    }
+    return count;
+}
+
+ModelCache::Handle ModelCache::Insert(const std::string& key, bool& created)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    std::weak_ptr<SharedModel>& entry = cache[key];
+    if (Handle existing = entry.lock())
+    {
+        created = false;
+        return existing;
+    }
+
+    Handle model(new SharedModel(), &ReleaseModel);
+    entry   = model;
+    created = true;
+
+    // Drop entries whose models are gone.
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+        if (it->second.expired())
+            it = cache.erase(it);
+        else
+            ++it;
+    }
+    return model;
+}
+
+ModelCache::Handle ModelCache::Acquire(const std::string& key, std::function<Model()> load)
+{
+    bool  created = false;
+    Handle model  = Insert(key, created);
+    if (!created)
+        return model;
+
+    // GPU upload: now on the GL thread, otherwise at the next Pump(). The task
+    // holds a handle, so the entry outlives a release before the upload.
+    MainThreadQueue::RunOrQueue([model, load]()
+    {
+        model->model  = load();
+        model->loaded = true;
+    });
+    return model;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "raylib.h"
+
+// Model shared through ModelCache. Mutable: renderers still set the material
+// shader / color right before they draw it.
+struct SharedModel
+{
+    Model model {};
+    bool  loaded = false;   // set on the GL thread once the upload ran
+};
+
+// ModelCache:
+// - Hands out one GPU model per built-in primitive (keyed by its generation
+//   parameters) and per model file (keyed by path), so identical geometry is
+//   generated, uploaded and held in GPU memory once however many objects use it.
+// - Handles are reference counted: the model is unloaded (on the GL thread)
+//   when the last handle is released. A later Acquire loads it again.
+// - Acquire is thread-safe. Off the GL thread (async scene loads) the upload is
+//   queued on MainThreadQueue; the handle reports loaded once it ran.
+// - OBJ files are parsed on the acquiring thread (ObjLoader) and queue one
+//   upload per mesh and per material; other formats load in one LoadModel
+//   task on the GL thread, parse included.
+class ModelCache
+{
+public:
+    using Handle = std::shared_ptr<SharedModel>;
+
+    static Handle AcquireCube(float width, float height, float length);
+    static Handle AcquireSphere(float radius, int rings, int slices);
+    static Handle AcquirePlane(float width, float length, int resX, int resZ);
+    static Handle AcquireFile(const std::string& path);
+
+    // Models currently shared (cache entries with live handles).
+    static std::size_t GetLiveCount();
+
+private:
+    // Shared entry for key; created is set if this call made it (and must load it).
+    static Handle Insert(const std::string& key, bool& created);
+
+    // Shared entry for key; load runs on the GL thread the first time.
+    static Handle Acquire(const std::string& key, std::function<Model()> load);
+};
@@ -0,0 +1,285 @@
+#include "ObjLoader.h"
+#include "raymath.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+namespace
+{
+    struct MaterialInfo
+    {
+        Color       diffuse = WHITE;   // Kd missing: white
+        std::string diffuseMap;        // resolved path of map_Kd
+    };
+
+    // Triangle corners of one material, already expanded (unindexed).
+    struct MeshData
+    {
+        std::vector<float> vertices;
+        std::vector<float> texcoords;
+        std::vector<float> normals;
+    };
+
+    std::string DirectoryOf(const std::string& path)
+    {
+        const std::size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    }
+
+    bool IsAbsolute(const std::string& path)
+    {
+        return (!path.empty() && (path[0] == '/' || path[0] == '\\')) ||
+               (path.size() > 1 && path[1] == ':');
+    }
+
+    // Calls fn(keyword, rest) for every non-empty line; rest is trimmed.
+    template <typename Fn>
+    void ForEachLine(const char* text, Fn&& fn)
+    {
+        std::string line;
+        while (*text)
+        {
+            const char* end = text;
+            while (*end && *end != '\n')
+                ++end;
+            line.assign(text, end);
+            text = *end ? end + 1 : end;
+
+            const std::size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#')
+                continue;
+            const std::size_t keyEnd = line.find_first_of(" \t", first);
+            const std::size_t rest   = keyEnd == std::string::npos ? std::string::npos
+                                                                   : line.find_first_not_of(" \t", keyEnd);
+            const std::size_t last   = line.find_last_not_of(" \t\r");
+
+            fn(line.substr(first, keyEnd == std::string::npos ? std::string::npos : keyEnd - first),
+               rest == std::string::npos ? std::string() : line.substr(rest, last + 1 - rest));
+        }
+    }
+
+    void LoadMaterials(const std::string& path,
+                       std::vector<MaterialInfo>& materials,
+                       std::map<std::string, int>& names)
+    {
+        char* text = LoadFileText(path.c_str());
+        if (!text)
+            return;
+
+        const std::string folder = DirectoryOf(path);
+        ForEachLine(text, [&](const std::string& key, const std::string& rest)
+        {
+            if (key == "newmtl")
+            {
+                names[rest] = static_cast<int>(materials.size());
+                materials.push_back(MaterialInfo());
+            }
+            else if (materials.empty())
+            {
+                return;
+            }
+            else if (key == "Kd")
+            {
+                float rgb[3] = { 1.0f, 1.0f, 1.0f };
+                const char* cursor = rest.c_str();
+                for (float& channel : rgb)
+                {
+                    char* next = nullptr;
+                    channel = std::strtof(cursor, &next);
+                    cursor = next;
+                }
+                materials.back().diffuse = {
+                    static_cast<unsigned char>(Clamp(rgb[0], 0.0f, 1.0f) * 255.0f),
+                    static_cast<unsigned char>(Clamp(rgb[1], 0.0f, 1.0f) * 255.0f),
+                    static_cast<unsigned char>(Clamp(rgb[2], 0.0f, 1.0f) * 255.0f),
+                    255
+                };
+            }
+            else if (key == "map_Kd" && !rest.empty())
+            {
+                materials.back().diffuseMap = IsAbsolute(rest) ? rest : folder + rest;
+            }
+        });
+
+        UnloadFileText(text);
+    }
+
+    // OBJ index (1-based, negative counts back from the end) to 0-based; -1 if invalid.
+    int ResolveIndex(long index, std::size_t count)
+    {
+        const long resolved = index > 0 ? index - 1 : static_cast<long>(count) + index;
+        return resolved >= 0 && resolved < static_cast<long>(count) ? static_cast<int>(resolved) : -1;
+    }
+
+    template <typename T>
+    T* CopyToRaylib(const std::vector<T>& values)
+    {
+        T* copy = static_cast<T*>(MemAlloc(static_cast<unsigned int>(values.size() * sizeof(T))));
+        std::memcpy(copy, values.data(), values.size() * sizeof(T));
+        return copy;
+    }
+}
+
+bool ObjLoader::Load(const std::string& path, ObjModelData& out)
+{
+    char* text = LoadFileText(path.c_str());
+    if (!text)
+        return false;
+
+    std::vector<Vector3> positions;
+    std::vector<Vector2> uvs;
+    std::vector<Vector3> normals;
+
+    std::vector<MaterialInfo>  materials;
+    std::map<std::string, int> materialNames;
+    std::vector<MeshData>      meshes(1);
+    int                        current = 0;
+
+    // Corners of the face being read: position, texcoord, normal (-1: absent).
+    struct Corner { int v, vt, vn; };
+    std::vector<Corner> face;
+
+    const std::string folder = DirectoryOf(path);
+    ForEachLine(text, [&](const std::string& key, const std::string& rest)
+    {
+        const char* cursor = rest.c_str();
+        char*       next   = nullptr;
+
+        if (key == "v" || key == "vn")
+        {
+            Vector3 value;
+            value.x = std::strtof(cursor, &next); cursor = next;
+            value.y = std::strtof(cursor, &next); cursor = next;
+            value.z = std::strtof(cursor, &next);
+            (key == "v" ? positions : normals).push_back(value);
+        }
+        else if (key == "vt")
+        {
+            Vector2 value;
+            value.x = std::strtof(cursor, &next); cursor = next;
+            value.y = std::strtof(cursor, &next);
+            uvs.push_back(value);
+        }
+        else if (key == "mtllib")
+        {
+            LoadMaterials(IsAbsolute(rest) ? rest : folder + rest, materials, materialNames);
+            if (meshes.size() < materials.size())
+                meshes.resize(materials.size());
+        }
+        else if (key == "usemtl")
+        {
+            // Unknown names fall back to the first material.
+            const auto found = materialNames.find(rest);
+            current = found != materialNames.end() ? found->second : 0;
+        }
+        else if (key == "f")
+        {
+            face.clear();
+            while (*cursor)
+            {
+                Corner corner = { -1, -1, -1 };
+                corner.v = ResolveIndex(std::strtol(cursor, &next, 10), positions.size());
+                if (next == cursor)
+                    break;
+                cursor = next;
+                if (*cursor == '/')
+                {
+                    ++cursor;
+                    if (*cursor != '/')
+                    {
+                        corner.vt = ResolveIndex(std::strtol(cursor, &next, 10), uvs.size());
+                        cursor = next;
+                    }
+                    if (*cursor == '/')
+                    {
+                        ++cursor;
+                        corner.vn = ResolveIndex(std::strtol(cursor, &next, 10), normals.size());
+                        cursor = next;
+                    }
+                }
+                while (*cursor == ' ' || *cursor == '\t')
+                    ++cursor;
+                if (corner.v < 0)
+                    return;   // malformed face: skip it
+                face.push_back(corner);
+            }
+
+            MeshData& mesh = meshes[static_cast<std::size_t>(current)];
+            for (std::size_t i = 1; i + 1 < face.size(); ++i)
+            {
+                const Corner  tri[3]     = { face[0], face[i], face[i + 1] };
+                const Vector3 faceNormal = Vector3Normalize(Vector3CrossProduct(
+                    Vector3Subtract(positions[tri[1].v], positions[tri[0].v]),
+                    Vector3Subtract(positions[tri[2].v], positions[tri[0].v])));
+
+                for (const Corner& corner : tri)
+                {
+                    const Vector3 p  = positions[corner.v];
+                    const Vector2 uv = corner.vt >= 0 ? uvs[corner.vt] : Vector2{ 0.0f, 0.0f };
+                    const Vector3 n  = corner.vn >= 0 ? normals[corner.vn] : faceNormal;
+
+                    mesh.vertices.insert(mesh.vertices.end(), { p.x, p.y, p.z });
+                    mesh.texcoords.insert(mesh.texcoords.end(), { uv.x, 1.0f - uv.y });
+                    mesh.normals.insert(mesh.normals.end(), { n.x, n.y, n.z });
+                }
+            }
+        }
+    });
+
+    UnloadFileText(text);
+
+    int meshCount = 0;
+    for (const MeshData& mesh : meshes)
+    {
+        if (!mesh.vertices.empty())
+            ++meshCount;
+    }
+    if (meshCount == 0)
+        return false;
+
+    if (materials.empty())
+        materials.push_back(MaterialInfo());
+
+    Model& model = out.model;
+    model           = Model{};
+    model.transform = MatrixIdentity();
+
+    model.meshCount    = meshCount;
+    model.meshes       = static_cast<Mesh*>(MemAlloc(static_cast<unsigned int>(meshCount * sizeof(Mesh))));
+    model.meshMaterial = static_cast<int*>(MemAlloc(static_cast<unsigned int>(meshCount * sizeof(int))));
+
+    int index = 0;
+    for (std::size_t material = 0; material < meshes.size(); ++material)
+    {
+        const MeshData& data = meshes[material];
+        if (data.vertices.empty())
+            continue;
+
+        Mesh& mesh = model.meshes[index];
+        mesh.vertexCount   = static_cast<int>(data.vertices.size() / 3);
+        mesh.triangleCount = mesh.vertexCount / 3;
+        mesh.vertices      = CopyToRaylib(data.vertices);
+        mesh.texcoords     = CopyToRaylib(data.texcoords);
+        mesh.normals       = CopyToRaylib(data.normals);
+        model.meshMaterial[index] = static_cast<int>(material);
+        ++index;
+    }
+
+    // Materials are set up on the GL thread; decode their textures here.
+    model.materialCount = static_cast<int>(materials.size());
+    model.materials     = static_cast<Material*>(MemAlloc(static_cast<unsigned int>(materials.size() * sizeof(Material))));
+
+    out.diffuseColors.clear();
+    out.diffuseMaps.clear();
+    for (const MaterialInfo& material : materials)
+    {
+        Image map = {};
+        if (!material.diffuseMap.empty() && FileExists(material.diffuseMap.c_str()))
+            map = LoadImage(material.diffuseMap.c_str());
+
+        out.diffuseColors.push_back(material.diffuse);
+        out.diffuseMaps.push_back(map);
+    }
+    return true;
+}
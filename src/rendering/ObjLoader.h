@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "raylib.h"
+
+// CPU side of a model read by ObjLoader: nothing in it has touched GL yet.
+struct ObjModelData
+{
+    Model model {};                     // meshes hold CPU arrays only (not uploaded);
+                                        // materials are allocated but not set up
+    std::vector<Color> diffuseColors;   // per material: Kd
+    std::vector<Image> diffuseMaps;     // per material: decoded map_Kd (data null if none)
+};
+
+// ObjLoader:
+// - Reads a Wavefront OBJ file and its MTL library into ObjModelData without
+//   any GL call, so it can run on a loader worker. The caller uploads the
+//   meshes (UploadMesh) and sets up the materials on the GL thread.
+// - The result is laid out like raylib's LoadModel for OBJ: one unindexed
+//   mesh per material in use, polygons fanned into triangles, texcoords with
+//   v flipped. Corners without a normal get the face normal.
+// - Texture paths are resolved against the MTL file's folder (raylib changes
+//   the working directory instead, which other threads would see).
+class ObjLoader
+{
+public:
+    // False if the file cannot be read or holds no faces.
+    static bool Load(const std::string& path, ObjModelData& out);
+};
@@ -4,6 +4,7 @@
 #include "rlgl.h"
 
 #include "GameObject.h"
+#include "SceneGraph.h"
 #include "Transform3D.h"
 #include "CameraComponent.h"
 #include "LightComponent.h"
@@ -64,6 +65,12 @@ bool RenderPipeline::Initialize()
     MeshRenderer::SetGlobalShader(&m_lightingShader);
     MeshRenderer::SetShadowShader(&m_shadowShader);
 
+    // Renderers emit draw packets into the queue; primitives are drawn
+    // instanced when both shaders take instance attributes
+    m_instancing.Initialize(&m_lightingShader, &m_shadowShader);
+    m_renderQueue.Initialize(&m_lightingShader, &m_shadowShader, &m_instancing);
+    MeshRenderer::SetRenderQueue(&m_renderQueue);
+
     // Cache uniform locations we need every frame
     m_locViewPos    = GetShaderLocation(m_lightingShader, "u_viewPos");
     m_locLightSpace = GetShaderLocation(m_lightingShader, "u_lightSpaceMatrix");
@@ -84,18 +91,16 @@ Shader* RenderPipeline::GetShadowShader()
     return &m_shadowShader;
 }
 
-void RenderPipeline::SetScene(const std::shared_ptr<GameObject>& scene,
-                              GameObject* player,
-                              CameraComponent* camera,
-                              LightComponent* sunLight,
-                              ShadowMap* shadowMap)
+void RenderPipeline::SetScene(SceneGraph* scene,
+                              GameObjectHandle player,
+                              GameObjectHandle camera,
+                              GameObjectHandle sun)
 {
     // Renderer just stores references; it does NOT control lifecycle.
-    m_scene     = scene;
-    m_player    = player;
-    m_camera    = camera;
-    m_sunLight  = sunLight;
-    m_shadowMap = shadowMap;
+    m_scene  = scene;
+    m_player = player;
+    m_camera = camera;
+    m_sun    = sun;
 }
 
 void RenderPipeline::Tick()
@@ -116,47 +121,85 @@ void RenderPipeline::Tick()
     // NOTE: We NO LONGER call m_scene->Update / LateUpdate here.
     // The scene is assumed to already be in the correct state for this frame.
 
+    // Resolve this frame's key objects (any of them may have been destroyed).
+    GameObject*      player    = m_scene->Resolve(m_player);
+    GameObject*      cameraGO  = m_scene->Resolve(m_camera);
+    GameObject*      sunGO     = m_scene->Resolve(m_sun);
+    CameraComponent* camera    = cameraGO ? cameraGO->GetComponent<CameraComponent>() : nullptr;
+    LightComponent*  sunLight  = sunGO ? sunGO->GetComponent<LightComponent>() : nullptr;
+    ShadowMap*       shadowMap = sunGO ? sunGO->GetComponent<ShadowMap>() : nullptr;
+
+    // Render between the last two simulation steps.
+    MeshRenderer::SetInterpolationAlpha(m_interpolationAlpha);
+    if (camera)
+        camera->SyncToTransform(m_interpolationAlpha);
+
     // --- SHADOW PASS (unchanged) ---
-    if (m_sunLight && m_shadowMap)
+    if (sunLight && shadowMap)
     {
         Vector3 focus    = { 0.0f, 0.0f, 0.0f };
-        Vector3 lightDir = m_sunLight->GetDirection();
+        Vector3 lightDir = sunLight->GetDirection();
 
-        m_shadowMap->UpdateLightMatrices(lightDir, focus);
+        shadowMap->UpdateLightMatrices(lightDir, focus);
 
-        Matrix lightView = m_shadowMap->GetLightView();
-        Matrix lightProj = m_shadowMap->GetLightProj();
+        Matrix lightView = shadowMap->GetLightView();
+        Matrix lightProj = shadowMap->GetLightProj();
 
         Matrix lightSpace = MatrixMultiply(lightView, lightProj);
 
         if (m_locLightSpace >= 0)
             SetShaderValueMatrix(m_lightingShader, m_locLightSpace, lightSpace);
 
-        m_shadowMap->BeginDepthPass();
+        // BeginTextureMode resets the matrices: load the light's after it.
+        auto loadLightMatrices = [&]()
+        {
+            rlMatrixMode(RL_PROJECTION);
+            rlLoadIdentity();
+            rlMultMatrixf(MatrixToFloat(lightProj));
+
+            rlMatrixMode(RL_MODELVIEW);
+            rlLoadIdentity();
+            rlMultMatrixf(MatrixToFloat(lightView));
+        };
+
+        // Static casters: only when the cached layer is out of date.
+        const uint64_t staticCasters = StaticShadowSignature();
+        if (shadowMap->NeedsStaticPass(staticCasters))
+        {
+            shadowMap->BeginStaticPass();
+            loadLightMatrices();
+
+            MeshRenderer::SetShadowCasters(MeshRenderer::ShadowCasters::Static);
+            m_renderQueue.Begin(RenderQueue::Pass::Shadow);
+            m_scene->DrawShadow();
+            m_renderQueue.Submit();
 
-        rlMatrixMode(RL_PROJECTION);
-        rlLoadIdentity();
-        rlMultMatrixf(MatrixToFloat(lightProj));
+            shadowMap->EndStaticPass(staticCasters);
+        }
 
-        rlMatrixMode(RL_MODELVIEW);
-        rlLoadIdentity();
-        rlMultMatrixf(MatrixToFloat(lightView));
+        // Dynamic casters, every frame, over a copy of the static layer.
+        shadowMap->BeginDepthPass();
+        loadLightMatrices();
 
+        MeshRenderer::SetShadowCasters(MeshRenderer::ShadowCasters::Dynamic);
+        m_renderQueue.Begin(RenderQueue::Pass::Shadow);
         m_scene->DrawShadow();
+        m_renderQueue.Submit();
+        MeshRenderer::SetShadowCasters(MeshRenderer::ShadowCasters::All);
 
-        m_shadowMap->EndDepthPass();
+        shadowMap->EndDepthPass();
     }
 
     // --- Per-frame uniforms for lighting shader ---
-    if (m_camera && m_locViewPos >= 0 && m_player)
+    if (camera && m_locViewPos >= 0 && player)
     {
-        Vector3 camPos = m_player->GetTransform()->GetPosition();
+        Vector3 camPos = player->GetTransform()->GetInterpolatedWorldPosition(m_interpolationAlpha);
         SetShaderValue(m_lightingShader, m_locViewPos, &camPos.x, SHADER_UNIFORM_VEC3);
     }
 
-    if (m_shadowMap)
+    if (shadowMap)
     {
-        Texture depthTex = m_shadowMap->GetDepthTexture();
+        Texture depthTex = shadowMap->GetDepthTexture();
         rlActiveTextureSlot(1);
         rlEnableTexture(depthTex.id);
         rlActiveTextureSlot(0);
@@ -167,16 +210,19 @@ void RenderPipeline::Tick()
     {
         ClearBackground(SKYBLUE);
 
-        if (m_camera)
+        if (camera)
         {
-            m_camera->BeginMode();
+            camera->BeginMode();
+            CullRenderers();
+            m_renderQueue.Begin(RenderQueue::Pass::Main);
             m_scene->Draw();
-            m_camera->EndMode();
+            m_renderQueue.Submit();
+            camera->EndMode();
         }
 
-        if (m_showShadowMap && m_shadowMap)
+        if (m_showShadowMap && shadowMap)
         {
-            Texture shadowTex = m_shadowMap->GetDepthTexture();
+            Texture shadowTex = shadowMap->GetDepthTexture();
             int size = 256;
             Rectangle src = 
             { 
@@ -201,10 +247,25 @@ void RenderPipeline::Tick()
 
         DrawText("3DSRC INDEV v0.02", 10, 10, 20, WHITE);
         DrawFPS(10, 40);
+        DrawText(TextFormat("Instanced: %d draws / %d objects",
+                            m_instancing.GetDrawCount(), m_instancing.GetInstanceCount()),
+                 10, 100, 20, WHITE);
+        DrawText(TextFormat("Culling: %d / %d visible",
+                            m_culler.GetVisibleCount(), m_culler.GetTestedCount()),
+                 10, 130, 20, WHITE);
+        DrawText(TextFormat("Queue: %d packets / %d draws / %d binds",
+                            m_renderQueue.GetPacketCount(), m_renderQueue.GetDrawCount(),
+                            m_renderQueue.GetStateChangeCount()),
+                 10, 160, 20, WHITE);
+        if (shadowMap)
+        {
+            DrawText(TextFormat("Static shadows: %d redraws", shadowMap->GetStaticRedrawCount()),
+                     10, 190, 20, WHITE);
+        }
         // Draw text showing if player is grounded
-        if (m_player)
+        if (player)
         {
-            PlayerController* pc = m_player->GetComponent<PlayerController>();
+            PlayerController* pc = player->GetComponent<PlayerController>();
             if (pc)
             {
                 const char* groundedText = pc->IsGrounded() ? "Grounded" : "Airborne";
@@ -215,8 +276,64 @@ void RenderPipeline::Tick()
     EndDrawing();
 }
 
+uint64_t RenderPipeline::StaticShadowSignature()
+{
+    // Every enabled static caster, in scene order: adding, removing, moving or
+    // re-modelling one changes the signature.
+    const ComponentTypeId rendererType = ComponentType::Id<MeshRenderer>();
+
+    uint64_t signature = 1469598103934665603ull;
+    m_scene->ForEachActive([&](GameObject* obj)
+    {
+        obj->ForEachComponent([&](ComponentTypeId typeId, const Component& component)
+        {
+            if (typeId != rendererType || !component.IsEnabled())
+                return;
+
+            const MeshRenderer& renderer = static_cast<const MeshRenderer&>(component);
+            if (renderer.IsStaticShadowCaster())
+                signature = (signature ^ renderer.GetShadowCasterHash()) * 1099511628211ull;
+        });
+    });
+    return signature;
+}
+
+void RenderPipeline::CullRenderers()
+{
+    // Same view / projection the main pass draws with (see InstanceBatcher::Flush).
+    const Matrix view = MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview());
+    m_culler.SetFrustum(MatrixMultiply(view, rlGetMatrixProjection()));
+
+    m_culler.Clear();
+    m_cullRenderers.clear();
+
+    m_scene->ForEachActive([this](GameObject* obj)
+    {
+        MeshRenderer* renderer = obj->GetComponent<MeshRenderer>();
+        if (!renderer || !renderer->IsEnabled())
+            return;
+
+        BoundingBox bounds;
+        if (renderer->GetWorldBounds(bounds))
+        {
+            m_culler.Add(bounds);
+            m_cullRenderers.push_back(renderer);
+        }
+        else
+        {
+            renderer->SetCulled(false);
+        }
+    });
+
+    m_culler.Cull();
+    for (std::size_t i = 0; i < m_cullRenderers.size(); ++i)
+        m_cullRenderers[i]->SetCulled(!m_culler.IsVisible(static_cast<int>(i)));
+}
+
 void RenderPipeline::Shutdown()
 {
+    MeshRenderer::SetRenderQueue(nullptr);
+    m_instancing.Shutdown();
     UnloadShader(m_lightingShader);
     UnloadShader(m_shadowShader);
 }
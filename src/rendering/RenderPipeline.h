@@ -1,14 +1,22 @@
 // RenderPipeline.h
 #pragma once
 
-#include <memory>
 #include "raylib.h"
+#include "GameObjectHandle.h"
+#include "InstanceBatcher.h"
+#include "FrustumCuller.h"
+#include "RenderQueue.h"
+
+#include <cstdint>
+#include <vector>
 
 // Forward declarations: we only need pointers/references here
 class GameObject;
+class SceneGraph;
 class CameraComponent;
 class LightComponent;
 class ShadowMap;
+class MeshRenderer;
 
 // Encapsulates rendering + shadow pass.
 // Owns shaders and knows how to render a bound scene.
@@ -24,12 +32,17 @@ public:
     Shader* GetLightingShader();
     Shader* GetShadowShader();
 
-    // Bind a scene and its key components (player, camera, sun light, shadow map).
-    void SetScene(const std::shared_ptr<GameObject>& scene,
-                  GameObject* player,
-                  CameraComponent* camera,
-                  LightComponent* sunLight,
-                  ShadowMap* shadowMap);
+    // Bind a scene and its key objects: player, the object with the CameraComponent,
+    // and the sun (LightComponent + ShadowMap). Objects are held by handle and
+    // re-resolved every frame, so destroying one simply disables its part.
+    void SetScene(SceneGraph* scene,
+                  GameObjectHandle player,
+                  GameObjectHandle camera,
+                  GameObjectHandle sun);
+
+    // Blend factor (0..1) between the last two fixed simulation steps,
+    // set by the main loop before each Tick().
+    void SetInterpolationAlpha(float alpha) { m_interpolationAlpha = alpha; }
 
     // One frame: update scene, run shadow pass, render.
     void Tick();
@@ -44,13 +57,29 @@ private:
     Shader m_lightingShader{};
     Shader m_shadowShader{};
 
-    std::shared_ptr<GameObject> m_scene;
-    GameObject*      m_player    = nullptr;
-    CameraComponent* m_camera    = nullptr;
-    LightComponent*  m_sunLight  = nullptr;
-    ShadowMap*       m_shadowMap = nullptr;
+    SceneGraph*      m_scene     = nullptr;
+    GameObjectHandle m_player;
+    GameObjectHandle m_camera;
+    GameObjectHandle m_sun;
 
     int  m_locViewPos    = -1;
     int  m_locLightSpace = -1;
     bool m_showShadowMap = true;
+
+    float m_interpolationAlpha = 1.0f;
+
+    // Sorted draw packets of both passes; primitives go on to the batcher
+    RenderQueue     m_renderQueue;
+    InstanceBatcher m_instancing;
+
+    // Camera frustum culling of the MeshRenderers before the main pass
+    FrustumCuller              m_culler;
+    std::vector<MeshRenderer*> m_cullRenderers;   // index = culler box index
+
+    // Test every enabled MeshRenderer against the current view / projection
+    // (call inside the camera's BeginMode) and flag the ones outside it.
+    void CullRenderers();
+
+    // Signature of the static shadow casters (see ShadowMap::NeedsStaticPass).
+    uint64_t StaticShadowSignature();
 };
@@ -0,0 +1,210 @@
+#include "RenderQueue.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <cstring>
+#include <utility>
+
+void RenderQueue::Initialize(Shader* lightingShader, Shader* shadowShader, InstanceBatcher* instanceBatcher)
+{
+    shaders[static_cast<int>(Pass::Main)]   = lightingShader;
+    shaders[static_cast<int>(Pass::Shadow)] = shadowShader;
+    batcher = instanceBatcher;
+}
+
+void RenderQueue::Begin(Pass newPass)
+{
+    pass = newPass;
+    packets.clear();
+    order.clear();
+
+    // Eye position of the pass: translation of the inverse view.
+    const Matrix view    = MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview());
+    const Matrix inverse = MatrixInvert(view);
+    viewPosition = { inverse.m12, inverse.m13, inverse.m14 };
+}
+
+void RenderQueue::Add(const DrawPacket& packet)
+{
+    if (!packet.mesh || packet.mesh->vaoId == 0)
+        return;
+
+    // Depth only: the texture does not matter.
+    unsigned int texture = 0;
+    if (pass == Pass::Main)
+    {
+        texture = packet.textureId;
+        if (texture == 0 && packet.material)
+            texture = packet.material->maps[MATERIAL_MAP_DIFFUSE].texture.id;
+    }
+
+    // Non-negative floats order like their bit patterns.
+    const Vector3 offset = {
+        packet.transform.m12 - viewPosition.x,
+        packet.transform.m13 - viewPosition.y,
+        packet.transform.m14 - viewPosition.z
+    };
+    const float distance = Vector3DotProduct(offset, offset);
+    uint32_t depth = 0;
+    std::memcpy(&depth, &distance, sizeof(depth));
+
+    packets.push_back(packet);
+    DrawPacket& added = packets.back();
+    added.sortKey = (static_cast<uint64_t>(texture & 0xFFFFu) << 48) |
+                    (static_cast<uint64_t>(packet.mesh->vaoId & 0xFFFFu) << 32) |
+                    depth;
+
+    order.push_back({ added.sortKey, static_cast<uint32_t>(packets.size() - 1) });
+}
+
+void RenderQueue::SortPackets()
+{
+    // LSD radix sort, one byte per pass. Stable, so equal keys keep emission order.
+    const std::size_t count = order.size();
+    scratch.resize(count);
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        std::size_t offsets[256] = {};
+        for (const SortEntry& entry : order)
+            ++offsets[(entry.key >> shift) & 0xFF];
+
+        // Every key has the same byte here (e.g. all one texture): nothing to do.
+        if (offsets[(order[0].key >> shift) & 0xFF] == count)
+            continue;
+
+        std::size_t sum = 0;
+        for (std::size_t& offset : offsets)
+        {
+            const std::size_t bucket = offset;
+            offset = sum;
+            sum += bucket;
+        }
+
+        for (const SortEntry& entry : order)
+            scratch[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+        std::swap(order, scratch);
+    }
+}
+
+void RenderQueue::Submit()
+{
+    packetCount  = static_cast<int>(packets.size());
+    drawCount    = 0;
+    stateChanges = 0;
+    if (packets.empty())
+        return;
+
+    SortPackets();
+
+    const bool instancing = batcher && batcher->IsEnabled();
+    if (instancing)
+        batcher->Begin(pass);
+
+    individual.clear();
+    for (const SortEntry& entry : order)
+    {
+        const DrawPacket& packet = packets[entry.index];
+        if (instancing && packet.instanceKey >= 0)
+            batcher->Add(packet.instanceKey, *packet.mesh, packet.textureId, packet.transform, packet.color);
+        else
+            individual.push_back(&packet);
+    }
+
+    DrawIndividual();
+
+    if (instancing)
+    {
+        batcher->Flush();
+        drawCount += batcher->GetDrawCount();
+    }
+}
+
+void RenderQueue::DrawIndividual()
+{
+    const Shader* shader = shaders[static_cast<int>(pass)];
+    if (individual.empty() || !shader || shader->id == 0)
+        return;
+
+    // Same matrices as raylib's DrawMesh, but uploaded once per pass.
+    const Matrix transform = rlGetMatrixTransform();
+    const Matrix view      = rlGetMatrixModelview();
+    const Matrix viewProj  = MatrixMultiply(view, rlGetMatrixProjection());
+    const int*   locs      = shader->locs;
+    const bool   main      = pass == Pass::Main;
+
+    rlEnableShader(shader->id);
+    if (locs[SHADER_LOC_MATRIX_VIEW] >= 0)
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_VIEW], view);
+    if (locs[SHADER_LOC_MATRIX_PROJECTION] >= 0)
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_PROJECTION], rlGetMatrixProjection());
+    if (main && locs[SHADER_LOC_MAP_DIFFUSE] >= 0)
+    {
+        const int slot = 0;
+        rlSetUniform(locs[SHADER_LOC_MAP_DIFFUSE], &slot, RL_SHADER_UNIFORM_INT, 1);
+    }
+
+    unsigned int boundTexture = 0;
+    unsigned int boundVao     = 0;
+    Color        boundColor   = { 0, 0, 0, 0 };
+    bool         colorSet     = false;
+
+    for (const DrawPacket* packet : individual)
+    {
+        if (main)
+        {
+            unsigned int texture = packet->textureId;
+            if (texture == 0 && packet->material)
+                texture = packet->material->maps[MATERIAL_MAP_DIFFUSE].texture.id;
+            if (texture == 0)
+                texture = rlGetTextureIdDefault();
+
+            if (texture != boundTexture)
+            {
+                rlActiveTextureSlot(0);
+                rlEnableTexture(texture);
+                boundTexture = texture;
+                ++stateChanges;
+            }
+
+            const Color c = packet->color;
+            if (locs[SHADER_LOC_COLOR_DIFFUSE] >= 0 &&
+                (!colorSet || c.r != boundColor.r || c.g != boundColor.g || c.b != boundColor.b || c.a != boundColor.a))
+            {
+                const float values[4] = { c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+                rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], values, RL_SHADER_UNIFORM_VEC4, 1);
+                boundColor = c;
+                colorSet   = true;
+            }
+        }
+
+        if (packet->mesh->vaoId != boundVao)
+        {
+            if (!rlEnableVertexArray(packet->mesh->vaoId))
+                continue;
+            boundVao = packet->mesh->vaoId;
+            ++stateChanges;
+        }
+
+        const Matrix model = MatrixMultiply(packet->transform, transform);
+        if (locs[SHADER_LOC_MATRIX_MODEL] >= 0)
+            rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MODEL], model);
+        if (locs[SHADER_LOC_MATRIX_NORMAL] >= 0)
+            rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_NORMAL], MatrixTranspose(MatrixInvert(model)));
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(model, viewProj));
+
+        if (packet->mesh->indices)
+            rlDrawVertexArrayElements(0, packet->mesh->triangleCount * 3, nullptr);
+        else
+            rlDrawVertexArray(0, packet->mesh->vertexCount);
+        ++drawCount;
+    }
+
+    rlDisableVertexArray();
+    if (main)
+    {
+        rlActiveTextureSlot(0);
+        rlDisableTexture();
+    }
+    rlDisableShader();
+}
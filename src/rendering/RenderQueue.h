@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "raylib.h"
+#include "InstanceBatcher.h"
+
+// One draw as emitted by a component: everything Submit() needs, nothing it
+// has to look up again.
+struct DrawPacket
+{
+    uint64_t        sortKey     = 0;         // filled in by RenderQueue::Add
+    const Mesh*     mesh        = nullptr;
+    const Material* material    = nullptr;   // diffuse texture if textureId is 0
+    Matrix          transform {};            // full model matrix
+    Color           color       = WHITE;
+    unsigned int    textureId   = 0;         // diffuse override (0: material's)
+    int             instanceKey = -1;        // >= 0: may be drawn instanced with equal keys
+};
+
+// RenderQueue:
+// - Components emit DrawPackets into the queue of the current pass instead of
+//   drawing immediately; Submit() sorts them and draws them in one go.
+// - The program is fixed per pass (lighting / shadow shader), so the sort key
+//   orders by diffuse texture, then vertex array, then depth (front to back,
+//   from the pass's view position):
+//       [63..48 texture] [47..32 vertex array] [31..0 squared distance, float bits]
+//   Keys are radix-sorted (8 bits per pass, constant bytes skipped).
+// - Sorted packets are submitted with cached state: the shader is bound once,
+//   and the texture, color and vertex array only when they change.
+// - Packets with an instanceKey go to the InstanceBatcher (if it can draw
+//   instances), in sorted order, and are flushed after the individual draws.
+// - Everything is opaque for now: there is no back-to-front translucent list.
+class RenderQueue
+{
+public:
+    using Pass = InstanceBatcher::Pass;
+
+    RenderQueue() = default;
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+
+    // Shaders of the two passes; batcher may be null (no instancing).
+    void Initialize(Shader* lightingShader, Shader* shadowShader, InstanceBatcher* batcher);
+
+    // Start collecting the packets of one pass. The view (for depth) is read
+    // from rlgl at Begin, so call it with the pass's matrices set up.
+    void Begin(Pass pass);
+    Pass GetPass() const { return pass; }
+
+    void Add(const DrawPacket& packet);
+
+    // Sort and draw everything added since Begin().
+    void Submit();
+
+    // Statistics of the last Submit().
+    int GetPacketCount() const { return packetCount; }
+    int GetDrawCount() const { return drawCount; }            // individual + instanced calls
+    int GetStateChangeCount() const { return stateChanges; }  // texture / vertex array binds
+
+private:
+    struct SortEntry
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    Shader*          shaders[2] = { nullptr, nullptr };
+    InstanceBatcher* batcher    = nullptr;
+    Pass             pass       = Pass::Main;
+    Vector3          viewPosition { 0.0f, 0.0f, 0.0f };
+
+    std::vector<DrawPacket> packets;
+    std::vector<SortEntry>  order;
+    std::vector<SortEntry>  scratch;
+
+    std::vector<const DrawPacket*> individual;   // sorted packets not drawn instanced
+
+    int packetCount  = 0;
+    int drawCount    = 0;
+    int stateChanges = 0;
+
+    void SortPackets();
+
+    // Draw the packets that did not go to the batcher, one call each.
+    void DrawIndividual();
+};
@@ -1,15 +1,43 @@
 #include "ShadowMap.h"
 #include "rlgl.h"
+#include "MainThreadQueue.h"
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 
 ShadowMap::ShadowMap(Shader* shader, int res)
     : shadowShader(shader)
     , resolution(res)
 {
-    // Create a standard render texture
+    // GPU resources are created by the first pass (on the GL thread), so a
+    // shadow map built and dropped on a loader worker never touches GL.
+}
+
+ShadowMap::~ShadowMap()
+{
+    // GPU release: on the GL thread (shadow maps may be destroyed on a worker).
+    const RenderTexture2D shadow = shadowRT;
+    const RenderTexture2D cached = staticRT;
+    if (shadow.id == 0 && cached.id == 0)
+        return;
+
+    MainThreadQueue::RunOrQueue([shadow, cached]()
+    {
+        UnloadRenderTexture(shadow);
+        UnloadRenderTexture(cached);
+    });
+}
+
+void ShadowMap::CreateTargets()
+{
+    if (shadowRT.id != 0)
+        return;
+
+    // Create a standard render texture, and a twin for the static layer
+    // (same formats, so it can be blitted over)
     shadowRT = LoadRenderTexture(resolution, resolution);
-    
+    staticRT = LoadRenderTexture(resolution, resolution);
+
     printf("Shadow RT created: texture.id=%d, depth.id=%d\n", shadowRT.texture.id, shadowRT.depth.id);
 
     if (shadowShader)
@@ -19,11 +47,6 @@ ShadowMap::ShadowMap(Shader* shader, int res)
     }
 }
 
-ShadowMap::~ShadowMap()
-{
-    UnloadRenderTexture(shadowRT);
-}
-
 void ShadowMap::UpdateLightMatrices(Vector3 lightDir, Vector3 focusPoint)
 {
     Vector3 dir = Vector3Normalize(lightDir);
@@ -47,13 +70,50 @@ void ShadowMap::UpdateLightMatrices(Vector3 lightDir, Vector3 focusPoint)
                             1.0f, 80.0f);
 }
 
-void ShadowMap::BeginDepthPass()
+bool ShadowMap::NeedsStaticPass(uint64_t casterSignature) const
 {
-    BeginTextureMode(shadowRT);
-    
+    return !staticValid ||
+           casterSignature != staticSignature ||
+           std::memcmp(&lightView, &staticLightView, sizeof(Matrix)) != 0 ||
+           std::memcmp(&lightProj, &staticLightProj, sizeof(Matrix)) != 0;
+}
+
+void ShadowMap::BeginStaticPass()
+{
+    CreateTargets();
+    BeginTextureMode(staticRT);
+
     // Clear to BLACK (depth = 0.0)
     ClearBackground(BLACK);
-    
+
+    rlEnableDepthTest();
+    rlEnableDepthMask();
+}
+
+void ShadowMap::EndStaticPass(uint64_t casterSignature)
+{
+    EndTextureMode();
+
+    staticValid     = true;
+    staticSignature = casterSignature;
+    staticLightView = lightView;
+    staticLightProj = lightProj;
+    ++staticRedraws;
+}
+
+void ShadowMap::BeginDepthPass()
+{
+    CreateTargets();
+    BeginTextureMode(shadowRT);
+
+    // Start from the static layer: depth too, so dynamic casters behind a
+    // static one fail the depth test instead of overwriting it.
+    rlBindFramebuffer(RL_READ_FRAMEBUFFER, staticRT.id);
+    rlBlitFramebuffer(0, 0, resolution, resolution,
+                      0, 0, resolution, resolution,
+                      0x00004100);   // GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT
+    rlBindFramebuffer(RL_READ_FRAMEBUFFER, shadowRT.id);
+
     // Make sure depth test is enabled
     rlEnableDepthTest();
     
@@ -4,14 +4,28 @@
 #include "raylib.h"
 #include "raymath.h"
 
+#include <cstdint>
+
 /// <summary>
 /// Manages a RenderTexture used as a shadow map for a single
 /// directional light, plus its view/projection matrices.
+/// Static casters are rendered into a second, cached target that is only
+/// redrawn when the light matrices or the static casters change; each frame
+/// the cache (color and depth) is copied into the shadow map and only the
+/// dynamic casters are drawn on top of it.
 /// </summary>
 class ShadowMap : public Component
 {
 private:
     RenderTexture2D shadowRT{};
+    RenderTexture2D staticRT{};   // static casters only
+
+    // What the static layer was drawn for.
+    bool     staticValid     = false;
+    uint64_t staticSignature = 0;
+    Matrix   staticLightView = MatrixIdentity();
+    Matrix   staticLightProj = MatrixIdentity();
+    int      staticRedraws   = 0;
     Shader* shadowShader = nullptr;
 
     Matrix lightView = MatrixIdentity();
@@ -27,16 +41,34 @@ private:
 
     int resolution = 2048;
 
+    // Load the render targets on first use (GL thread only).
+    void CreateTargets();
+
 public:
     ShadowMap(Shader* shader, int res = 2048);
     ~ShadowMap();
 
     void UpdateLightMatrices(Vector3 lightDir, Vector3 focusPoint);
 
+    // True if the static layer is out of date: never drawn, the light
+    // matrices moved, or casterSignature (of the static casters) changed.
+    bool NeedsStaticPass(uint64_t casterSignature) const;
+
+    // Redraw the static layer. EndStaticPass records what it was drawn for.
+    // The first pass of either kind creates the render targets.
+    void BeginStaticPass();
+    void EndStaticPass(uint64_t casterSignature);
+
+    // Per-frame pass: starts from a copy of the static layer, so only the
+    // dynamic casters are drawn between these.
     void BeginDepthPass();
     void EndDepthPass();
 
+    // Times the static layer was redrawn.
+    int GetStaticRedrawCount() const { return staticRedraws; }
+
     Texture GetDepthTexture() const;
+    int GetResolution() const { return resolution; }
 
     const Matrix& GetLightView() const { return lightView; }
     const Matrix& GetLightProj() const { return lightProj; }
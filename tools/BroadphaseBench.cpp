@@ -0,0 +1,239 @@
+// BroadphaseBench.cpp
+// Compares the collider broadphases on crowds of player-sized boxes.
+// Build and run with `make bench` (needs only the raylib headers, no window).
+//
+// Every frame each agent takes a small random step, the broadphase is
+// updated, then every agent queries its own box and casts a short ray down.
+// Brute force is timed on a sample of queries and scaled to the full count.
+
+#include "AabbTree.h"
+#include "SpatialHashGrid.h"
+#include "raymath.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Vector3 kAgentSize   = { 0.7f, 2.0f, 0.7f };   // PlayerController's collider
+    const float   kAgentSpacing = 3.0f;                  // average distance between agents
+    const float   kStepLength   = 0.1f;                  // movement per frame
+    const int     kFrames       = 10;
+    const int     kBruteSample  = 200;                   // brute-force queries timed per frame
+
+    using Clock = std::chrono::steady_clock;
+
+    double MillisecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    BoundingBox AgentBox(Vector3 center)
+    {
+        const Vector3 half = Vector3Scale(kAgentSize, 0.5f);
+        return { Vector3Subtract(center, half), Vector3Add(center, half) };
+    }
+
+    struct Crowd
+    {
+        std::vector<Vector3>     positions;
+        std::vector<BoundingBox> boxes;
+        std::vector<Vector3>     steps;   // this frame's displacement
+        float                    extent;  // half side of the square the agents roam
+    };
+
+    Crowd MakeCrowd(int count, std::mt19937& rng)
+    {
+        Crowd crowd;
+        crowd.extent = 0.5f * kAgentSpacing * std::sqrt(static_cast<float>(count));
+
+        std::uniform_real_distribution<float> xz(-crowd.extent, crowd.extent);
+        crowd.positions.resize(count);
+        crowd.boxes.resize(count);
+        crowd.steps.resize(count);
+        for (int i = 0; i < count; ++i)
+        {
+            crowd.positions[i] = { xz(rng), 1.0f, xz(rng) };
+            crowd.boxes[i]     = AgentBox(crowd.positions[i]);
+        }
+        return crowd;
+    }
+
+    void StepCrowd(Crowd& crowd, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> angle(0.0f, 2.0f * PI);
+        for (std::size_t i = 0; i < crowd.positions.size(); ++i)
+        {
+            const float a = angle(rng);
+            Vector3 step = { std::cos(a) * kStepLength, 0.0f, std::sin(a) * kStepLength };
+
+            Vector3 next = Vector3Add(crowd.positions[i], step);
+            if (std::fabs(next.x) > crowd.extent || std::fabs(next.z) > crowd.extent)
+                step = Vector3Negate(step);
+
+            crowd.positions[i] = Vector3Add(crowd.positions[i], step);
+            crowd.boxes[i]     = AgentBox(crowd.positions[i]);
+            crowd.steps[i]     = step;
+        }
+    }
+
+    Ray DownRay(const BoundingBox& box)
+    {
+        Ray ray;
+        ray.position  = { (box.min.x + box.max.x) * 0.5f, box.min.y - 0.01f, (box.min.z + box.max.z) * 0.5f };
+        ray.direction = { 0.0f, -1.0f, 0.0f };
+        return ray;
+    }
+
+    struct Timings
+    {
+        double update = 0.0;   // ms per frame
+        double query  = 0.0;   // ms per frame (all agents)
+        double ray    = 0.0;   // ms per frame (all agents)
+        long   pairs  = 0;     // overlapping agent pairs seen in the last frame (x2)
+    };
+
+    // Runs the frame loop for a broadphase with the AabbTree / SpatialHashGrid API.
+    template <typename Broadphase>
+    Timings RunIndexed(Broadphase& broadphase, int count, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        Crowd crowd = MakeCrowd(count, rng);
+
+        std::vector<int> proxies(count);
+        for (int i = 0; i < count; ++i)
+            proxies[i] = broadphase.CreateProxy(crowd.boxes[i], reinterpret_cast<void*>(static_cast<std::intptr_t>(i)));
+
+        Timings t;
+        for (int frame = 0; frame < kFrames; ++frame)
+        {
+            StepCrowd(crowd, rng);
+
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < count; ++i)
+                broadphase.MoveProxy(proxies[i], crowd.boxes[i], crowd.steps[i]);
+            t.update += MillisecondsSince(start);
+
+            long pairs = 0;
+            start = Clock::now();
+            for (int i = 0; i < count; ++i)
+            {
+                const BoundingBox& box = crowd.boxes[i];
+                broadphase.Query(box, [&](int proxy)
+                {
+                    const int other = static_cast<int>(reinterpret_cast<std::intptr_t>(broadphase.GetUserData(proxy)));
+                    if (other != i && AabbTree::Overlaps(crowd.boxes[other], box))
+                        ++pairs;
+                    return true;
+                });
+            }
+            t.query += MillisecondsSince(start);
+            t.pairs = pairs;
+
+            start = Clock::now();
+            for (int i = 0; i < count; ++i)
+            {
+                broadphase.Raycast(DownRay(crowd.boxes[i]), 1.0f, [](int, float maxDistance)
+                {
+                    return maxDistance;
+                });
+            }
+            t.ray += MillisecondsSince(start);
+        }
+
+        t.update /= kFrames;
+        t.query  /= kFrames;
+        t.ray    /= kFrames;
+        return t;
+    }
+
+    Timings RunBruteForce(int count, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        Crowd crowd = MakeCrowd(count, rng);
+
+        const int sample = count < kBruteSample ? count : kBruteSample;
+        const double scale = static_cast<double>(count) / sample;
+
+        Timings t;
+        for (int frame = 0; frame < kFrames; ++frame)
+        {
+            StepCrowd(crowd, rng);
+
+            long pairs = 0;
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < sample; ++i)
+            {
+                for (int other = 0; other < count; ++other)
+                {
+                    if (other != i && AabbTree::Overlaps(crowd.boxes[other], crowd.boxes[i]))
+                        ++pairs;
+                }
+            }
+            t.query += MillisecondsSince(start) * scale;
+            t.pairs = static_cast<long>(pairs * scale);
+
+            start = Clock::now();
+            for (int i = 0; i < sample; ++i)
+            {
+                const Ray ray = DownRay(crowd.boxes[i]);
+                const Vector3 invDir = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+                float distance;
+                for (int other = 0; other < count; ++other)
+                    AabbTree::RayEntersBox(ray.position, invDir, crowd.boxes[other], 1.0f, distance);
+            }
+            t.ray += MillisecondsSince(start) * scale;
+        }
+
+        t.query /= kFrames;
+        t.ray   /= kFrames;
+        return t;
+    }
+
+    void Print(const char* name, const Timings& t)
+    {
+        std::printf("  %-12s update %9.3f ms   query %9.3f ms   raycast %9.3f ms   pairs %ld\n",
+                    name, t.update, t.query, t.ray, t.pairs);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<int> counts = { 1000, 10000, 100000 };
+    if (argc > 1)
+    {
+        counts.clear();
+        for (int i = 1; i < argc; ++i)
+            counts.push_back(std::atoi(argv[i]));
+    }
+
+    std::printf("Broadphase benchmark: %d frames, agents %.1fx%.1fx%.1f, per-frame averages\n",
+                kFrames, kAgentSize.x, kAgentSize.y, kAgentSize.z);
+
+    for (int count : counts)
+    {
+        if (count <= 0)
+            continue;
+
+        const unsigned seed = 1234u + static_cast<unsigned>(count);
+        std::printf("\n%d colliders\n", count);
+
+        {
+            AabbTree tree;
+            Print("AabbTree", RunIndexed(tree, count, seed));
+        }
+        {
+            SpatialHashGrid grid;
+            Timings t = RunIndexed(grid, count, seed);
+            Print("SpatialHash", t);
+            std::printf("  %-12s cell size %.2f\n", "", grid.GetCellSize());
+        }
+        Print("BruteForce", RunBruteForce(count, seed));
+    }
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+// CharacterBench.cpp
+// Times CharacterMotorSystem on a crowd of NPCs walking around a level of
+// static boxes, with and without JobSystem workers.
+// Build and run with `make bench` (links raylib for its collision helpers, no window).
+//
+// Every step each agent keeps walking in its current direction, picks a new
+// one about once a second and jumps now and then. Runs the same crowd twice
+// (serial, then on all cores) and checks that both end in the same state.
+
+#include "CharacterMotor.h"
+#include "PhysicsWorld.h"
+#include "SceneGraph.h"
+#include "GameObject.h"
+#include "Transform3D.h"
+#include "BoxCollider.h"
+#include "JobSystem.h"
+#include "raymath.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Vector3 kAgentSize    = { 0.7f, 2.0f, 0.7f };  // PlayerController's collider
+    const float   kAgentSpacing = 3.0f;                  // average distance between agents
+    const float   kObstacleGap  = 8.0f;                  // distance between obstacle boxes
+    const float   kStep         = 1.0f / 60.0f;
+    const int     kSteps        = 120;
+
+    using Clock = std::chrono::steady_clock;
+
+    double MillisecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Ground plus a grid of knee-high and wall-high boxes, all static.
+    void BuildLevel(SceneGraph& graph, float extent)
+    {
+        auto addBox = [&graph](Vector3 position, Vector3 size)
+        {
+            GameObject* obj = graph.CreateObject("Box");
+            obj->GetTransform()->SetPosition(position);
+            obj->AddComponent<BoxCollider>(size)->SetStatic(true);
+        };
+
+        addBox({ 0.0f, -0.5f, 0.0f }, { 2.0f * extent + 10.0f, 1.0f, 2.0f * extent + 10.0f });
+
+        int index = 0;
+        for (float x = -extent; x <= extent; x += kObstacleGap)
+        for (float z = -extent; z <= extent; z += kObstacleGap)
+        {
+            const float height = (index++ % 3 == 0) ? 2.5f : 0.5f;
+            addBox({ x + 1.5f, height * 0.5f, z + 1.5f }, { 2.0f, height, 2.0f });
+        }
+
+        graph.Start();
+    }
+
+    struct Result
+    {
+        double msPerStep = 0.0;
+        int    grounded  = 0;     // agents grounded after the last step
+        double checksum  = 0.0;   // sum of final positions
+    };
+
+    Result Run(const PhysicsWorld& world, int count, float extent, unsigned seed)
+    {
+        const Vector3     half     = Vector3Scale(kAgentSize, 0.5f);
+        const BoundingBox localBox = { Vector3Negate(half), half };
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> xz(-extent, extent);
+        std::uniform_real_distribution<float> angle(0.0f, 2.0f * PI);
+        std::uniform_int_distribution<int>    chance(0, 59);
+
+        CharacterMotorSystem motors;
+        std::vector<int> agents(count);
+        for (int i = 0; i < count; ++i)
+            agents[i] = motors.AddAgent({ xz(rng), half.y + 0.01f, xz(rng) }, localBox);
+
+        Result result;
+        for (int step = 0; step < kSteps; ++step)
+        {
+            // Input as data: a few agents change direction each step.
+            for (int i = 0; i < count; ++i)
+            {
+                if (step > 0 && chance(rng) != 0)
+                    continue;
+                const float a = angle(rng);
+                motors.SetCommand(agents[i], { std::cos(a), 0.0f, std::sin(a) }, chance(rng) < 6);
+            }
+
+            const Clock::time_point start = Clock::now();
+            motors.Step(&world, kStep);
+            result.msPerStep += MillisecondsSince(start);
+        }
+        result.msPerStep /= kSteps;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const CharacterState state = motors.GetState(agents[i]);
+            result.grounded += state.grounded ? 1 : 0;
+            result.checksum += state.position.x + state.position.y + state.position.z;
+        }
+        return result;
+    }
+
+    void Print(const char* name, const Result& r)
+    {
+        std::printf("  %-10s %8.3f ms/step  (%5.1f%% of a 60 Hz step)   grounded %d\n",
+                    name, r.msPerStep, r.msPerStep * 100.0 / (kStep * 1000.0), r.grounded);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<int> counts = { 1000, 5000, 20000 };
+    if (argc > 1)
+    {
+        counts.clear();
+        for (int i = 1; i < argc; ++i)
+            counts.push_back(std::atoi(argv[i]));
+    }
+
+    std::printf("Character motor benchmark: %d steps at 60 Hz, agents %.1fx%.1fx%.1f\n",
+                kSteps, kAgentSize.x, kAgentSize.y, kAgentSize.z);
+
+    for (int count : counts)
+    {
+        if (count <= 0)
+            continue;
+
+        const float    extent = 0.5f * kAgentSpacing * std::sqrt(static_cast<float>(count));
+        const unsigned seed   = 4321u + static_cast<unsigned>(count);
+
+        PhysicsWorld world;
+        SceneGraph   graph;
+        graph.SetPhysicsWorld(&world);
+        BuildLevel(graph, extent);
+        world.SyncTransforms();
+
+        std::printf("\n%d agents, %zu colliders\n", count, world.GetColliderCount());
+
+        const Result serial = Run(world, count, extent, seed);
+        Print("serial", serial);
+
+        Result parallel;
+        {
+            JobSystem jobs;
+            parallel = Run(world, count, extent, seed);
+            std::printf("  %-10s %d workers + main thread\n", "", jobs.GetWorkerCount());
+        }
+        Print("parallel", parallel);
+
+        if (std::fabs(serial.checksum - parallel.checksum) > 1e-3 * count)
+            std::printf("  MISMATCH: serial and parallel runs ended in different states\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+// SceneBench.cpp
+// Times the SceneGraph per-step passes (Update, LateUpdate, Draw) over a flat
+// scene of objects with a few small components each.
+// Build and run with `make bench`, which builds it twice: with the chunk pools
+// (CHUNK_POOL_STORAGE=1, the default) and with plain heap allocations (=0).
+//
+// Objects are created with unrelated heap allocations in between, like a level
+// loaded next to its assets, so the heap build gets its usual scatter. The
+// passes themselves are the same in both builds: each object's component list.
+
+#include "SceneGraph.h"
+#include "GameObject.h"
+#include "Component.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const int kObjectCounts[] = { 1000, 10000, 100000 };
+    const int kSteps          = 200;
+
+    using Clock = std::chrono::steady_clock;
+
+    double MillisecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Small components with a little work per callback, so the time goes into
+    // reaching them rather than into what they do.
+    class Spinner : public Component
+    {
+    public:
+        float angle = 0.0f;
+        float speed = 1.0f;
+        void Update(float deltaTime) override { angle += speed * deltaTime; }
+    };
+
+    class Follower : public Component
+    {
+    public:
+        float value  = 0.0f;
+        float target = 1.0f;
+        void LateUpdate(float deltaTime) override { value += (target - value) * deltaTime; }
+    };
+
+    class Counter : public Component
+    {
+    public:
+        static long long draws;
+        int calls = 0;
+        void Draw() override { ++calls; ++draws; }
+    };
+
+    long long Counter::draws = 0;
+
+    struct Result
+    {
+        double updateMs = 0.0;   // per step
+        double drawMs   = 0.0;   // per step
+    };
+
+    Result Run(int count)
+    {
+        std::mt19937 rng(1234u);
+        std::uniform_int_distribution<int> junkSize(16, 512);
+        std::vector<std::unique_ptr<char[]>> junk;
+
+        SceneGraph graph;
+        for (int i = 0; i < count; ++i)
+        {
+            GameObject* obj = graph.CreateObject("Object");
+            junk.emplace_back(new char[junkSize(rng)]);
+            obj->AddComponent<Spinner>();
+            junk.emplace_back(new char[junkSize(rng)]);
+            obj->AddComponent<Follower>();
+            junk.emplace_back(new char[junkSize(rng)]);
+            obj->AddComponent<Counter>();
+        }
+        graph.Start();
+
+        // Warm up once so the flattened array is built outside the timing.
+        graph.Update(1.0f / 60.0f);
+        graph.LateUpdate(1.0f / 60.0f);
+        graph.Draw();
+
+        Result result;
+        Clock::time_point start = Clock::now();
+        for (int step = 0; step < kSteps; ++step)
+        {
+            graph.Update(1.0f / 60.0f);
+            graph.LateUpdate(1.0f / 60.0f);
+        }
+        result.updateMs = MillisecondsSince(start) / kSteps;
+
+        start = Clock::now();
+        for (int step = 0; step < kSteps; ++step)
+            graph.Draw();
+        result.drawMs = MillisecondsSince(start) / kSteps;
+
+        return result;
+    }
+}
+
+int main()
+{
+    std::printf("SceneGraph passes, %s storage, %d steps, 3 components per object\n",
+                CHUNK_POOL_STORAGE ? "chunk pool" : "heap", kSteps);
+    std::printf("%10s %16s %14s\n", "objects", "update+late ms", "draw ms");
+
+    for (int count : kObjectCounts)
+    {
+        const Result result = Run(count);
+        std::printf("%10d %16.3f %14.3f\n", count, result.updateMs, result.drawMs);
+    }
+
+    // Keeps the draw calls observable.
+    std::printf("(%lld draws)\n", Counter::draws);
+    return 0;
+}